@@ -0,0 +1,139 @@
+// AnalysisHistograms.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the AnalysisHistograms class.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<exception>
+#include<stdexcept>
+#include<string>
+#include<thread>
+#include<vector>
+
+#include "AnalysisHistograms.h"
+
+using namespace ParticleDetector;
+using DetectorSubsystems::SubDetectorType;
+using DetectorSubsystems::number_of_sub_detector_types;
+
+// [CONSTRUCTORS]
+
+AnalysisHistograms::AnalysisHistograms(std::size_t number_of_shards, const HistogramBinning& mass_binning,
+  const HistogramBinning& energy_binning) :
+  invariant_mass{std::make_unique<ConcurrentHistogram>(mass_binning, number_of_shards)},
+  missing_energy{std::make_unique<ConcurrentHistogram>(energy_binning, number_of_shards)}
+{
+  for(auto& histogram : sub_detector_energy)
+  {
+    histogram = std::make_unique<ConcurrentHistogram>(energy_binning, number_of_shards);
+  }
+}
+
+// [FILL]
+
+void AnalysisHistograms::fill_invariant_mass(std::size_t shard, double mass)
+{
+  invariant_mass->get_shard(shard).fill(mass);
+}
+
+void AnalysisHistograms::fill_missing_energy(std::size_t shard, double met)
+{
+  missing_energy->get_shard(shard).fill(met);
+}
+
+void AnalysisHistograms::fill_sub_detector_energies(std::size_t shard, const DetectorReadings& readings)
+{
+  for(std::size_t type = 0; type < number_of_sub_detector_types; ++type)
+  {
+    if(readings.energies[type] > 0.0) {sub_detector_energy[type]->get_shard(shard).fill(readings.energies[type]);}
+  }
+}
+
+// Function to fill a range of events and a range of particles of a processed batch into one shard
+void AnalysisHistograms::fill_range_into_shard(std::size_t shard, const EventSummaryBatch& summaries,
+  const ReadingsBatch& readings, std::size_t first_event, std::size_t last_event, std::size_t first_particle,
+  std::size_t last_particle)
+{
+  auto mass_shard = invariant_mass->get_shard(shard);
+  auto met_shard = missing_energy->get_shard(shard);
+  for(std::size_t event = first_event; event < last_event; ++event)
+  {
+    mass_shard.fill(summaries.invariant_mass[event]);
+    met_shard.fill(summaries.detected_met[event]);
+  }
+  for(std::size_t type = 0; type < number_of_sub_detector_types; ++type)
+  {
+    auto energy_shard = sub_detector_energy[type]->get_shard(shard);
+    const auto& column = readings.energy_columns[type];
+    for(std::size_t particle = first_particle; particle < last_particle; ++particle)
+    {
+      if(column[particle] > 0.0) {energy_shard.fill(column[particle]);}
+    }
+  }
+}
+
+void AnalysisHistograms::fill_batch(std::size_t shard, const EventSummaryBatch& summaries,
+  const ReadingsBatch& readings)
+{
+  fill_range_into_shard(shard, summaries, readings, 0, summaries.size(), 0, readings.size());
+}
+
+// Function to fill a processed batch from several threads:
+// - Splits the events and the particles into one contiguous range per shard
+// - Each thread fills only its own shards, so no locks or atomics are needed
+// - The calling thread takes the first range, as in Detector::process_batch
+void AnalysisHistograms::fill_batch(const EventSummaryBatch& summaries, const ReadingsBatch& readings)
+{
+  const std::size_t number_of_events = summaries.size();
+  const std::size_t number_of_particles = readings.size();
+  const std::size_t number_of_ranges = std::max<std::size_t>(1, std::min(get_number_of_shards(),
+    std::max(number_of_events, number_of_particles)));
+  auto fill_range = [&](std::size_t range)
+  {
+    fill_range_into_shard(range, summaries, readings, number_of_events * range / number_of_ranges,
+      number_of_events * (range + 1) / number_of_ranges, number_of_particles * range / number_of_ranges,
+      number_of_particles * (range + 1) / number_of_ranges);
+  };
+  std::vector<std::exception_ptr> errors(number_of_ranges);
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_ranges - 1);
+  auto run_range = [&](std::size_t range)
+  {
+    try {fill_range(range);}
+    catch(...) {errors[range] = std::current_exception();}
+  };
+  for(std::size_t range = 1; range < number_of_ranges; ++range) {threads.emplace_back(run_range, range);}
+  run_range(0);
+  for(auto& thread : threads) {thread.join();}
+  for(const auto& error : errors)
+  {
+    if(error) {std::rethrow_exception(error);}
+  }
+}
+
+// [MERGE]
+
+void AnalysisHistograms::reset()
+{
+  invariant_mass->reset();
+  missing_energy->reset();
+  for(auto& histogram : sub_detector_energy) {histogram->reset();}
+}
+
+void AnalysisHistograms::print() const
+{
+  merge_invariant_mass().print("Invariant mass [GeV]");
+  merge_missing_energy().print("Detected missing transverse energy [GeV]");
+  for(std::size_t type = 0; type < number_of_sub_detector_types; ++type)
+  {
+    const auto sub_detector = static_cast<SubDetectorType>(type);
+    merge_sub_detector_energy(sub_detector).print(std::string(DetectorSubsystems::sub_detector_type_name(
+      sub_detector)) + " energy [GeV]");
+  }
+}
@@ -0,0 +1,100 @@
+// AnalysisHistograms.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `AnalysisHistograms` class, which collects the event-level
+// results of the detector in concurrent histograms instead of only printing them:
+// - the invariant mass of each event (Detector::calculate_invariant_mass)
+// - the detected missing transverse energy of each event (Detector::calculate_missing_energy)
+// - the energy measured by each sub-detector, one histogram per SubDetectorType
+//
+// Every histogram has one shard per worker thread (see ConcurrentHistogram). Worker threads
+// pass their own shard index to the fill methods, and the merge methods add the shards once
+// the workers are done.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef ANALYSIS_HISTOGRAMS_H
+#define ANALYSIS_HISTOGRAMS_H
+
+#include<array>
+#include<cstddef>
+#include<memory>
+
+#include "DetectorReadings.h"
+#include "EventSummaryBatch.h"
+#include "Histogram.h"
+#include "ReadingsBatch.h"
+#include "SubDetectorType.h"
+
+namespace ParticleDetector
+{
+  class AnalysisHistograms
+  {
+  private:
+    std::unique_ptr<ConcurrentHistogram> invariant_mass;
+    std::unique_ptr<ConcurrentHistogram> missing_energy;
+    std::array<std::unique_ptr<ConcurrentHistogram>, DetectorSubsystems::number_of_sub_detector_types>
+      sub_detector_energy;
+
+    // Fill events [first_event, last_event) and particles [first_particle, last_particle) of a
+    // processed batch into one shard
+    void fill_range_into_shard(std::size_t shard, const EventSummaryBatch& summaries, const ReadingsBatch& readings,
+      std::size_t first_event, std::size_t last_event, std::size_t first_particle, std::size_t last_particle);
+
+  public:
+    // Default binnings: 5 GeV bins up to 250 GeV for the mass and 5 GeV bins up to 200 GeV
+    // for MET and the sub-detector energies
+    static HistogramBinning default_mass_binning() {return HistogramBinning(50, 0.0, 250.0);}
+    static HistogramBinning default_energy_binning() {return HistogramBinning(40, 0.0, 200.0);}
+
+    // [RULE OF 5]
+    // Parameterised constructor, with one shard per worker thread; throws if number_of_shards is 0
+    explicit AnalysisHistograms(std::size_t number_of_shards, const HistogramBinning& mass_binning =
+      default_mass_binning(), const HistogramBinning& energy_binning = default_energy_binning());
+    // Not allowing copy or move operations as the histograms are filled through shard handles
+    // Copy constructor
+    AnalysisHistograms(const AnalysisHistograms& other) = delete;
+    // Move constructor
+    AnalysisHistograms(AnalysisHistograms&& other) = delete;
+    // Copy assignment operator
+    AnalysisHistograms& operator=(const AnalysisHistograms& other) = delete;
+    // Move assignment operator
+    AnalysisHistograms& operator=(AnalysisHistograms&& other) = delete;
+    // Destructor
+    ~AnalysisHistograms() = default;
+
+    // [GETTERS]
+    std::size_t get_number_of_shards() const {return invariant_mass->get_number_of_shards();}
+
+    // [FILL]
+    // Each thread must use its own shard index in [0, number of shards)
+    void fill_invariant_mass(std::size_t shard, double mass);
+    void fill_missing_energy(std::size_t shard, double met);
+    // Fill the energy of every sub-detector that recorded the particle (non-zero reading)
+    void fill_sub_detector_energies(std::size_t shard, const DetectorReadings& readings);
+    // Fill the whole of a processed batch, with up to one thread per shard: the event
+    // columns of `summaries` and the per-particle columns of `readings`
+    void fill_batch(const EventSummaryBatch& summaries, const ReadingsBatch& readings);
+    // Fill the whole of a processed batch into one shard from the calling thread, e.g. from a
+    // worker that already runs alongside others
+    void fill_batch(std::size_t shard, const EventSummaryBatch& summaries, const ReadingsBatch& readings);
+
+    // [MERGE]
+    Histogram merge_invariant_mass() const {return invariant_mass->merge();}
+    Histogram merge_missing_energy() const {return missing_energy->merge();}
+    Histogram merge_sub_detector_energy(DetectorSubsystems::SubDetectorType type) const
+    {
+      return sub_detector_energy[static_cast<std::size_t>(type)]->merge();
+    }
+    // Clear every histogram
+    void reset();
+    // Print every merged histogram
+    void print() const;
+  };
+} // namespace ParticleDetector
+
+#endif // ANALYSIS_HISTOGRAMS_H
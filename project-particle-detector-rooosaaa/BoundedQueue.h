@@ -0,0 +1,179 @@
+// BoundedQueue.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `BoundedQueue` class template, a fixed-capacity lock-free
+// queue that any number of threads can push to and pop from (multi-producer,
+// multi-consumer). It is the ring buffer of Dmitry Vyukov: every cell carries a sequence
+// number that tells producers and consumers whether the cell is free or full for their
+// lap of the ring, so a push or pop is one compare-and-swap on the shared position and
+// never takes a lock. The two positions live on separate cache lines.
+//
+// try_push and try_pop return immediately. push and pop wait (spinning briefly, then
+// yielding the CPU) while the queue is full or empty, so a full queue holds back its
+// producers (backpressure). close() wakes every waiting thread: push then fails, and pop
+// fails once the remaining items have been taken.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef BOUNDED_QUEUE_H
+#define BOUNDED_QUEUE_H
+
+#include<atomic>
+#include<cstddef>
+#include<memory>
+#include<stdexcept>
+#include<thread>
+#include<utility>
+
+#include "SimdSupport.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+#endif
+
+namespace ParticleDetector
+{
+  template<typename T>
+  class BoundedQueue
+  {
+  private:
+    struct Cell
+    {
+      std::atomic<std::size_t> sequence;
+      T value;
+    };
+
+    std::unique_ptr<Cell[]> cells;
+    std::size_t mask; // capacity - 1
+    alignas(DetectorSimd::cache_line_size) std::atomic<std::size_t> enqueue_position{0};
+    alignas(DetectorSimd::cache_line_size) std::atomic<std::size_t> dequeue_position{0};
+    alignas(DetectorSimd::cache_line_size) std::atomic<bool> closed{false};
+
+    // Wait a little longer on each failed attempt: spin first, then give up the CPU
+    static void back_off(unsigned int& attempt)
+    {
+      if(attempt < 64)
+      {
+#if defined(__x86_64__) || defined(__i386__)
+        _mm_pause();
+#endif
+        ++attempt;
+      }
+      else {std::this_thread::yield();}
+    }
+
+    // Claim the next cell and store the item in it; the item is only moved from on success
+    template<typename U> bool try_push_value(U&& item)
+    {
+      std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+      while(true)
+      {
+        Cell& cell = cells[position & mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+        if(difference == 0)
+        {
+          // The cell is free for this lap; claim it by advancing the position
+          if(enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          {
+            cell.value = std::forward<U>(item);
+            cell.sequence.store(position + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if(difference < 0) {return false;} // still full from the previous lap
+        else {position = enqueue_position.load(std::memory_order_relaxed);} // another producer won
+      }
+    }
+
+  public:
+    // [RULE OF 5]
+    // Parameterised constructor; throws unless the capacity is a power of two of at least 2
+    explicit BoundedQueue(std::size_t capacity) : mask{capacity - 1}
+    {
+      if(capacity < 2 || (capacity & (capacity - 1)) != 0) {throw std::invalid_argument(
+        "Error: Queue capacity must be a power of two of at least 2.");}
+      cells = std::make_unique<Cell[]>(capacity);
+      for(std::size_t i = 0; i < capacity; ++i) {cells[i].sequence.store(i, std::memory_order_relaxed);}
+    }
+    // Not allowing copy or move operations as other threads hold references to the queue
+    // Copy constructor
+    BoundedQueue(const BoundedQueue& other) = delete;
+    // Move constructor
+    BoundedQueue(BoundedQueue&& other) = delete;
+    // Copy assignment operator
+    BoundedQueue& operator=(const BoundedQueue& other) = delete;
+    // Move assignment operator
+    BoundedQueue& operator=(BoundedQueue&& other) = delete;
+    // Destructor
+    ~BoundedQueue() = default;
+
+    // [GETTERS]
+    std::size_t capacity() const {return mask + 1;}
+    bool is_closed() const {return closed.load(std::memory_order_acquire);}
+
+    // [METHODS]
+    // Add an item if there is space; returns false (leaving the item untouched) if the queue is full
+    bool try_push(T&& item) {return try_push_value(std::move(item));}
+    bool try_push(const T& item) {return try_push_value(item);}
+
+    // Take the oldest item if there is one; returns false if the queue is empty
+    bool try_pop(T& item)
+    {
+      std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+      while(true)
+      {
+        Cell& cell = cells[position & mask];
+        const std::size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+        if(difference == 0)
+        {
+          if(dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+          {
+            item = std::move(cell.value);
+            // Free the cell for the producers of the next lap
+            cell.sequence.store(position + mask + 1, std::memory_order_release);
+            return true;
+          }
+        }
+        else if(difference < 0) {return false;} // not filled yet
+        else {position = dequeue_position.load(std::memory_order_relaxed);} // another consumer won
+      }
+    }
+
+    // Add an item, waiting while the queue is full; returns false if the queue is closed
+    bool push(T item)
+    {
+      unsigned int attempt = 0;
+      while(!is_closed())
+      {
+        if(try_push(std::move(item))) {return true;}
+        back_off(attempt);
+      }
+      return false;
+    }
+
+    // Take the oldest item, waiting while the queue is empty; returns false once the queue
+    // is closed and empty
+    bool pop(T& item)
+    {
+      unsigned int attempt = 0;
+      while(true)
+      {
+        if(try_pop(item)) {return true;}
+        // Items pushed before close() are still handed out
+        if(is_closed()) {return try_pop(item);}
+        back_off(attempt);
+      }
+    }
+
+    // Stop accepting items and release every waiting thread
+    void close() {closed.store(true, std::memory_order_release);}
+  };
+} // namespace ParticleDetector
+
+#endif // BOUNDED_QUEUE_H
@@ -32,7 +32,7 @@ Calorimeter::Calorimeter(const std::string& calorimeter_name, int resolution,
 {
   sub_detector_type = calorimeter_name;
   set_calorimeter_layers(layers);
-  // The SubDetector base class constructor seeds the random generator
+  // The SubDetector base class constructor seeds the random stream
   // and validates the resolution
 }
 
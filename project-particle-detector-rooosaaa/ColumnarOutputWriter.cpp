@@ -0,0 +1,201 @@
+// ColumnarOutputWriter.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the ColumnarOutputWriter class. Each column copies its values
+// into a 64-byte aligned block buffer and writes the buffer to an unbuffered file stream
+// once it is full, so the file receives a few large writes instead of many small ones.
+// The entry count in each column header is filled in when the writer is closed.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<cstring>
+#include<fstream>
+#include<new>
+#include<stdexcept>
+
+#include "ColumnarOutputWriter.h"
+#include "EventFileFormat.h"
+
+using namespace ParticleDetector;
+
+namespace
+{
+  // Alignment of the block buffers
+  constexpr std::size_t buffer_alignment = 64;
+
+  // Release a block buffer allocated with aligned operator new
+  struct AlignedBufferDeleter
+  {
+    void operator()(unsigned char* buffer) const
+    {
+      ::operator delete[](buffer, std::align_val_t{buffer_alignment});
+    }
+  };
+
+  // Position of each column in ColumnarOutputWriter::columns
+  enum ColumnIndex : std::size_t
+  {
+    // Per particle (the four energies are in SubDetectorType order)
+    tracker_energy_column = 0,
+    pid_column = 4,
+    // Per event
+    event_number_column,
+    particle_count_column,
+    invariant_mass_column,
+    true_energy_column,
+    detected_energy_column,
+    true_met_column,
+    detected_met_column,
+    number_of_columns
+  };
+}
+
+// [COLUMN FILE]
+
+class ColumnarOutputWriter::ColumnFile
+{
+private:
+  std::string file_name;
+  std::ofstream output;
+  ColumnFileHeader header;
+  std::unique_ptr<unsigned char[], AlignedBufferDeleter> buffer;
+  std::size_t block_size;
+  std::size_t buffered_bytes;
+  // Write the buffered bytes to the file
+  void flush_block()
+  {
+    output.write(reinterpret_cast<const char*>(buffer.get()), static_cast<std::streamsize>(buffered_bytes));
+    if(!output) {throw std::runtime_error("Error: Failed to write column file " + file_name);}
+    buffered_bytes = 0;
+  }
+
+public:
+  ColumnFile(const std::string& name, const char* column_name, ColumnElementType element_type,
+    std::size_t element_size, std::size_t block_size_bytes) :
+    file_name{name}, header{}, buffer{static_cast<unsigned char*>(
+      ::operator new[](block_size_bytes, std::align_val_t{buffer_alignment}))},
+    block_size{block_size_bytes}, buffered_bytes{0}
+  {
+    // Blocks are buffered here, so the stream itself writes straight through
+    output.rdbuf()->pubsetbuf(nullptr, 0);
+    output.open(file_name, std::ios::binary | std::ios::trunc);
+    if(!output) {throw std::runtime_error("Error: Cannot create column file " + file_name);}
+    std::memcpy(header.magic, column_file_magic, sizeof(column_file_magic));
+    header.version = column_file_version;
+    header.byte_order_mark = ParticleSystem::event_file_byte_order_mark;
+    header.element_type = static_cast<std::uint8_t>(element_type);
+    header.element_size = static_cast<std::uint8_t>(element_size);
+    std::strncpy(header.column_name, column_name, sizeof(header.column_name) - 1);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  }
+
+  // Append `count` values of the column's element size
+  void append(const void* values, std::size_t count)
+  {
+    const unsigned char* data = static_cast<const unsigned char*>(values);
+    std::size_t bytes = count * header.element_size;
+    header.number_of_entries += count;
+    while(bytes > 0)
+    {
+      const std::size_t copied = std::min(bytes, block_size - buffered_bytes);
+      std::memcpy(buffer.get() + buffered_bytes, data, copied);
+      buffered_bytes += copied;
+      data += copied;
+      bytes -= copied;
+      if(buffered_bytes == block_size) {flush_block();}
+    }
+  }
+
+  // Write the last partial block and the final entry count
+  void close()
+  {
+    if(!output.is_open()) {return;}
+    if(buffered_bytes > 0) {flush_block();}
+    output.seekp(0);
+    output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    output.close();
+    if(!output) {throw std::runtime_error("Error: Failed to finish column file " + file_name);}
+  }
+};
+
+// [RULE OF 5]
+
+ColumnarOutputWriter::ColumnarOutputWriter(const std::string& prefix, std::size_t block_size_bytes) :
+  output_prefix{prefix}, particles_written{0}, events_written{0}
+{
+  if(block_size_bytes == 0) {throw std::invalid_argument("Error: Column block size must be positive.");}
+  block_size = (block_size_bytes + buffer_alignment - 1) / buffer_alignment * buffer_alignment;
+  // File names follow the column order of ColumnIndex
+  const struct {const char* name; ColumnElementType element_type; std::size_t element_size;} layout[] =
+  {
+    {"tracker_energy", ColumnElementType::Float64, sizeof(double)},
+    {"em_calorimeter_energy", ColumnElementType::Float64, sizeof(double)},
+    {"hadronic_calorimeter_energy", ColumnElementType::Float64, sizeof(double)},
+    {"muon_spectrometer_energy", ColumnElementType::Float64, sizeof(double)},
+    {"pid", ColumnElementType::UInt8, sizeof(IdentifiedParticle)},
+    {"event_number", ColumnElementType::UInt64, sizeof(std::uint64_t)},
+    {"number_of_particles", ColumnElementType::UInt64, sizeof(std::uint64_t)},
+    {"invariant_mass", ColumnElementType::Float64, sizeof(double)},
+    {"true_energy", ColumnElementType::Float64, sizeof(double)},
+    {"detected_energy", ColumnElementType::Float64, sizeof(double)},
+    {"true_met", ColumnElementType::Float64, sizeof(double)},
+    {"detected_met", ColumnElementType::Float64, sizeof(double)}
+  };
+  static_assert(sizeof(layout) / sizeof(layout[0]) == number_of_columns, "Every column needs a file");
+  for(const auto& column : layout)
+  {
+    columns.push_back(std::make_unique<ColumnFile>(output_prefix + "." + column.name + ".col", column.name,
+      column.element_type, column.element_size, block_size));
+  }
+}
+
+ColumnarOutputWriter::~ColumnarOutputWriter()
+{
+  // Destructors must not throw, so errors while closing are only reported by close() itself
+  try {close();}
+  catch(...) {}
+}
+
+// [METHODS]
+
+void ColumnarOutputWriter::write_batch(const ParticleSystem::ParticleBatchView& batch, const ReadingsBatch& readings,
+  const std::vector<IdentifiedParticle>& identified, const EventSummaryBatch& summaries)
+{
+  const std::size_t number_of_particles = batch.number_of_particles();
+  const std::size_t number_of_events = batch.number_of_events();
+  if(readings.size() != number_of_particles || identified.size() != number_of_particles ||
+    summaries.size() != number_of_events)
+  {
+    throw std::invalid_argument("Mismatch between batch, readings, identification and summaries in write_batch.");
+  }
+  for(std::size_t type = 0; type < readings.energy_columns.size(); ++type)
+  {
+    columns[tracker_energy_column + type]->append(readings.energy_columns[type].data(), number_of_particles);
+  }
+  columns[pid_column]->append(identified.data(), number_of_particles);
+  // Particle counts let readers map the per-particle columns back to events
+  std::vector<std::uint64_t> particle_counts(number_of_events);
+  for(std::size_t event = 0; event < number_of_events; ++event)
+  {
+    particle_counts[event] = batch.event_offsets[event + 1] - batch.event_offsets[event];
+  }
+  columns[event_number_column]->append(summaries.event_number.data(), number_of_events);
+  columns[particle_count_column]->append(particle_counts.data(), number_of_events);
+  columns[invariant_mass_column]->append(summaries.invariant_mass.data(), number_of_events);
+  columns[true_energy_column]->append(summaries.true_energy.data(), number_of_events);
+  columns[detected_energy_column]->append(summaries.detected_energy.data(), number_of_events);
+  columns[true_met_column]->append(summaries.true_met.data(), number_of_events);
+  columns[detected_met_column]->append(summaries.detected_met.data(), number_of_events);
+  particles_written += number_of_particles;
+  events_written += number_of_events;
+}
+
+void ColumnarOutputWriter::close()
+{
+  for(auto& column : columns) {column->close();}
+}
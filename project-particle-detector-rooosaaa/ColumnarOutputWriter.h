@@ -0,0 +1,108 @@
+// ColumnarOutputWriter.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Header file for the ColumnarOutputWriter class, a binary output sink for processed
+// batches. Instead of printing formatted text, every quantity is stored at full precision
+// in its own typed column file, named `<prefix>.<column>.col`:
+//
+//   Per particle: tracker_energy, em_calorimeter_energy, hadronic_calorimeter_energy,
+//                 muon_spectrometer_energy (double, GeV) and pid (uint8 IdentifiedParticle)
+//   Per event:    event_number, number_of_particles (uint64), invariant_mass, true_energy,
+//                 detected_energy, true_met, detected_met (double, GeV)
+//
+// Each column file starts with a 64-byte ColumnFileHeader followed by the raw values, so a
+// column can be loaded (or memory-mapped) directly as an array. Values are collected in a
+// 64-byte aligned buffer per column and written in large blocks.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef COLUMNAR_OUTPUT_WRITER_H
+#define COLUMNAR_OUTPUT_WRITER_H
+
+#include<cstddef>
+#include<cstdint>
+#include<memory>
+#include<string>
+#include<vector>
+
+#include "EventSummaryBatch.h"
+#include "ParticleBatchView.h"
+#include "ParticleIdentification.h"
+#include "ReadingsBatch.h"
+
+namespace ParticleDetector
+{
+  // Element type code stored in each column file header
+  enum class ColumnElementType : std::uint8_t
+  {
+    Float64 = 0,
+    UInt64 = 1,
+    UInt8 = 2
+  };
+
+  constexpr char column_file_magic[8] = {'P', 'D', 'C', 'O', 'L', 'U', 'M', 'N'};
+  constexpr std::uint32_t column_file_version = 1;
+
+  struct ColumnFileHeader
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order_mark; // same marker as the event file format
+    std::uint64_t number_of_entries;
+    std::uint8_t element_type; // ColumnElementType
+    std::uint8_t element_size; // bytes per value
+    std::uint8_t reserved[6];
+    char column_name[32]; // zero-terminated
+  };
+
+  static_assert(sizeof(ColumnFileHeader) == 64, "Column data must start on a 64-byte boundary");
+
+  class ColumnarOutputWriter
+  {
+  private:
+    // One open column file with its aligned block buffer (defined in the .cpp file)
+    class ColumnFile;
+    std::string output_prefix;
+    std::size_t block_size; // bytes per buffered block
+    std::vector<std::unique_ptr<ColumnFile>> columns; // in the order listed above
+    std::uint64_t particles_written;
+    std::uint64_t events_written;
+
+  public:
+    // Default block size in bytes (per column)
+    static constexpr std::size_t default_block_size = 1 << 20;
+
+    // [RULE OF 5]
+    // Parameterised constructor: creates one file per column (block size is rounded up to 64 bytes)
+    explicit ColumnarOutputWriter(const std::string& prefix, std::size_t block_size_bytes = default_block_size);
+    // Not allowing copy or move operations as the writer owns the open files
+    // Copy constructor
+    ColumnarOutputWriter(const ColumnarOutputWriter& other) = delete;
+    // Move constructor
+    ColumnarOutputWriter(ColumnarOutputWriter&& other) = delete;
+    // Copy assignment operator
+    ColumnarOutputWriter& operator=(const ColumnarOutputWriter& other) = delete;
+    // Move assignment operator
+    ColumnarOutputWriter& operator=(ColumnarOutputWriter&& other) = delete;
+    // Destructor: closes the files if close() has not been called
+    ~ColumnarOutputWriter();
+
+    // [GETTERS]
+    const std::string& get_output_prefix() const {return output_prefix;}
+    std::uint64_t number_of_particles_written() const {return particles_written;}
+    std::uint64_t number_of_events_written() const {return events_written;}
+
+    // [METHODS]
+    // Append the readings, identification and event summaries of a processed batch
+    void write_batch(const ParticleSystem::ParticleBatchView& batch, const ReadingsBatch& readings,
+      const std::vector<IdentifiedParticle>& identified, const EventSummaryBatch& summaries);
+    // Flush the remaining buffered values, write the entry counts and close every file
+    void close();
+  };
+} // namespace ParticleDetector
+
+#endif // COLUMNAR_OUTPUT_WRITER_H
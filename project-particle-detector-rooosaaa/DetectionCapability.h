@@ -0,0 +1,82 @@
+// DetectionCapability.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the compile-time table of which sub-detectors can detect which
+// particle types. Each particle type maps to a 4-bit mask with one bit per SubDetectorType,
+// so "can sub-detector S detect particle type P" is a single table load and AND:
+//
+//   Particle type | Tracker | EM Calorimeter | Hadronic Calorimeter | Muon Spectrometer
+//   Electron      |    x    |       x        |                      |
+//   Positron      |    x    |       x        |                      |
+//   Muon          |    x    |                |                      |         x
+//   Photon        |         |       x        |                      |
+//   Hadron        |    x    |                |          x           |
+//   Neutrino      |         |                |                      |
+//
+// The masks of all particles in a group can also be ORed together to find sub-detectors that
+// no particle in the group interacts with, which the batch path then skips entirely.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef DETECTION_CAPABILITY_H
+#define DETECTION_CAPABILITY_H
+
+#include<array>
+#include<cstddef>
+#include<cstdint>
+
+#include "ParticleType.h"
+#include "SubDetectorType.h"
+
+namespace DetectorSubsystems
+{
+  // Bit of a sub-detector type within a detectability mask
+  constexpr std::uint8_t sub_detector_bit(SubDetectorType type)
+  {
+    return static_cast<std::uint8_t>(1u << static_cast<unsigned int>(type));
+  }
+
+  // Detectability masks indexed by ParticleSystem::ParticleType
+  constexpr std::array<std::uint8_t, ParticleSystem::number_of_particle_types> detectability_masks =
+  {
+    // Electron
+    static_cast<std::uint8_t>(sub_detector_bit(SubDetectorType::Tracker) |
+      sub_detector_bit(SubDetectorType::EMCalorimeter)),
+    // Positron
+    static_cast<std::uint8_t>(sub_detector_bit(SubDetectorType::Tracker) |
+      sub_detector_bit(SubDetectorType::EMCalorimeter)),
+    // Muon
+    static_cast<std::uint8_t>(sub_detector_bit(SubDetectorType::Tracker) |
+      sub_detector_bit(SubDetectorType::MuonSpectrometer)),
+    // Photon (neutral, so only seen by the EM Calorimeter)
+    sub_detector_bit(SubDetectorType::EMCalorimeter),
+    // Hadron
+    static_cast<std::uint8_t>(sub_detector_bit(SubDetectorType::Tracker) |
+      sub_detector_bit(SubDetectorType::HadronicCalorimeter)),
+    // Neutrino (not detected by any sub-detector)
+    0
+  };
+
+  // Return the mask of sub-detectors that can detect a particle type
+  constexpr std::uint8_t detectability_mask(ParticleSystem::ParticleType particle_type)
+  {
+    return detectability_masks[static_cast<std::size_t>(particle_type)];
+  }
+
+  // Check if a sub-detector type can detect a particle type
+  constexpr bool can_be_detected(ParticleSystem::ParticleType particle_type, SubDetectorType sub_detector_type)
+  {
+    return (detectability_mask(particle_type) & sub_detector_bit(sub_detector_type)) != 0;
+  }
+
+  static_assert(can_be_detected(ParticleSystem::ParticleType::Muon, SubDetectorType::MuonSpectrometer),
+    "Muons must reach the Muon Spectrometer");
+  static_assert(detectability_mask(ParticleSystem::ParticleType::Neutrino) == 0,
+    "Neutrinos must not be detected");
+} // namespace DetectorSubsystems
+
+#endif // DETECTION_CAPABILITY_H
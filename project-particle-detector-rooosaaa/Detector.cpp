@@ -18,11 +18,20 @@
 // Please see the README file for details on compilation and execution of this
 // program.
 
+#include<algorithm>
+#include<array>
+#include<cmath>
+#include<exception>
 #include<iostream>
 #include<iomanip>
+#include<memory_resource>
+#include<sstream>
+#include<thread>
+#include<utility>
 #include<vector>
 
 #include "Detector.h"
+#include "Logging.h"
 #include "Tracker.h"
 #include "EMCalorimeter.h"
 #include "HadronicCalorimeter.h"
@@ -31,6 +40,9 @@
 #include "Particle.h"
 #include "FourMomentum.h"
 #include "DetectorConfig.h"
+#include "CounterRandom.h"
+#include "DetectionCapability.h"
+#include "StageTimer.h"
 
 using namespace ParticleDetector;
 
@@ -38,28 +50,30 @@ using namespace ParticleDetector;
 
 Detector::Detector()
 {
-  std::cout<<"Calling Detector default constructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling Detector default constructor.");
   // Set default detector name
   detector_name = "ATLAS";
-  std::cout<<"Detector "<<detector_name<<" initialised."<<std::endl;
+  DETECTOR_LOG_INFO("Detector "<<detector_name<<" initialised.");
   // Add sub-detectors
   create_standard_detectors();
   detector_status = false;
+  set_run_seed(DetectorRandom::default_run_seed);
 }
 
 Detector::Detector(const std::string& name)
 {
   // Validate detector name
   set_detector_name(name);
-  std::cout<<"Detector "<<detector_name<<" initialised."<<std::endl;
+  DETECTOR_LOG_INFO("Detector "<<detector_name<<" initialised.");
   // Add sub-detectors
   create_standard_detectors();
   detector_status = false;
+  set_run_seed(DetectorRandom::default_run_seed);
 }
 
 Detector::~Detector()
 {
-  std::cout<<"Detector "<<detector_name<<" destroyed."<<std::endl;
+  DETECTOR_LOG_INFO("Detector "<<detector_name<<" destroyed.");
 }
 
 bool Detector::validate_detector_name(const std::string& name)
@@ -82,11 +96,22 @@ void Detector::set_detector_name(std::string name)
 // Set the detector status (off or on)
 void Detector::set_detector_status(bool status)
 {
-  if(status == true) {std::cout<<"Detector switched on."<<std::endl;}
-  else if (status == false) {std::cout<<"Detector switched off."<<std::endl;}
+  if(status == true) {DETECTOR_LOG_INFO("Detector switched on.");}
+  else if (status == false) {DETECTOR_LOG_INFO("Detector switched off.");}
   detector_status = status;
 }
 
+// Set the run seed, which keys the draws of both detect_particle and process_batch
+void Detector::set_run_seed(std::uint64_t seed)
+{
+  run_seed = seed;
+}
+
+void Detector::set_resonance_windows(std::vector<ResonanceWindow> windows, const ResonanceScanOptions& options)
+{
+  resonance_scanner = ResonanceScanner(std::move(windows), options);
+}
+
 // [DETECTOR METHODS]
 
 // Function to validate the sub-detector configuration:
@@ -140,7 +165,7 @@ void Detector::create_standard_detectors()
   else if(detector_name == "CMS") {configure_detector<CMSConfig>(sub_detectors);}
   // Validate the configuration
   validate_sub_detector_configuration();
-  std::cout<<"Standard "<<detector_name<<" detector configured with all required sub-detectors.";
+  DETECTOR_LOG_INFO("Standard "<<detector_name<<" detector configured with all required sub-detectors.");
 }
 
 // Function to print the configuration of the detector
@@ -164,8 +189,9 @@ std::cout<<"==================================\n\n";
 // - Simulates detection by passing the particle through a sequence of sub-detectors
 // - Each sub-detector returns the amount of energy it measures
 // - The particle's remaining energy is updated after each detection step
-// - Returns a map associating each sub-detector's name with its recorded energy
-std::map<std::string, double> Detector::detect_particle(const Particle& particle) const
+// - Returns the readings with one fixed slot per sub-detector type
+DetectorReadings Detector::detect_particle(const Particle& particle, std::uint64_t event_number,
+  std::uint32_t particle_index) const
 {
   // Check if detector is active; throw error if not
   // Check that the particle has valid non-zero momentum; throw error if not
@@ -176,113 +202,256 @@ std::map<std::string, double> Detector::detect_particle(const Particle& particle
     if(particle.get_momentum().get_energy() <= 0 && particle.get_momentum().get_px() == 0 &&
       particle.get_momentum().get_py() == 0 &&  particle.get_momentum().get_pz() == 0)
       {throw std::invalid_argument("Error: Particle has no momentum. Cannot detect particle.");}
-    // Initialise map to store energy readings per sub-detector
-    // Using a map allows easy access to readings by sub-detector type
-    std::map<std::string, double> readings;
+    // Initialise fixed-size readings (one slot per sub-detector type, all zero)
+    // Stored inline, so no heap allocation is needed per particle
+    DETECTOR_TIME_STAGE(DetectorMetrics::Stage::DetectParticle, 1);
+    DetectorReadings readings;
     // Extract particle's total true energy
     double true_energy = particle.get_momentum().get_energy();
 
     // Loop through each sub-detector and simulate detection
     // - Call detect_particle on sub-detector with current energy
-    // - Store detected energy in readings map, using sub-detector type as key
-    // - Using a map for easy access to readings by sub-detector type
+    // - Store detected energy in the slot of that sub-detector's type
     // - Update the remaining energy if any energy was detected
     for(const auto& sub_detector : sub_detectors)
     {
-      double detected_energy = sub_detector->detect_particle(particle, true_energy);
-      readings[sub_detector->get_sub_detector_type()] = detected_energy;
+      DETECTOR_TIME_STAGE(DetectorMetrics::sub_detector_stage(sub_detector->get_sub_detector_type_id()), 1);
+      double detected_energy = sub_detector->detect_particle(particle, true_energy, run_seed, event_number,
+        particle_index);
+      readings[sub_detector->get_sub_detector_type_id()] = detected_energy;
       if(detected_energy != 0.0) {true_energy = detected_energy;} // Update remaining energy
     }
     // Return the full set of recorded detector readings
-    std::cout<<"Particle has passed through the detector."<<std::endl;
-    std::cout<<"Detector readings recorded."<<std::endl;
+    DETECTOR_LOG_INFO("Particle has passed through the detector.");
+    DETECTOR_LOG_INFO("Detector readings recorded.");
     return readings;
   }
 }
 
-// Function to identify a particle based on detector readings
-std::string Detector::identify_particle(const std::map<std::string, double>& detector_readings)
+// Function to detect a whole batch of particles:
+// - Throws an error if the detector is switched off
+// - Follows the same sequence of sub-detectors and energy updates as detect_particle,
+//   but reads the particle columns directly instead of going through Particle objects
+// - The output column and detectability bit of each sub-detector are resolved once up front,
+//   so the inner loop only does table lookups and the energy measurement
+// - With more than one thread, the particles are shared out by a WorkStealingScheduler
+//   (see the scheduler overload below)
+// - Smearing draws are keyed by (run seed, event number, particle index, sub-detector),
+//   so the readings are identical for any number of threads or batch sharding
+void Detector::process_batch(const ParticleBatch& batch, ReadingsBatch& readings,
+  unsigned int number_of_threads) const
 {
-  // Initialise boolean flags for each sub-detector
-  // These flags will be set to true if the corresponding sub-detector has detected the particle
-  bool detected_by_tracker = false;
-  bool detected_by_em_calorimeter = false;
-  bool detected_by_hadronic_calorimeter = false;
-  bool detected_by_muon_spectrometer = false;
-
-  // Iterate through the detector readings
-  // Each entry contains the name of a sub-detector and the energy it recorded
-  for(const auto& reading : detector_readings)
+  // Particles added after the last end_event() must belong to an event
+  if(batch.event_offsets.back() != batch.number_of_particles()) {throw std::logic_error(
+    "Error: Batch contains particles outside a closed event. Call end_event() before processing.");}
+  process_batch(batch.view(), readings, number_of_threads);
+}
+
+// Function to detect the particles of a batch view (see the ParticleBatch overload above)
+void Detector::process_batch(const ParticleBatchView& batch, ReadingsBatch& readings,
+  unsigned int number_of_threads) const
+{
+  if(number_of_threads == 0) {number_of_threads = std::max(1u, std::thread::hardware_concurrency());}
+  if(number_of_threads > 1)
   {
-    const std::string& type = reading.first; // Name of that sub-detector
-    double energy = reading.second; // Energy recorded in that sub-detector
-    // If energy > 0, the particle interacted with this sub-detector
-    if(energy > 0)
+    WorkStealingScheduler scheduler(number_of_threads);
+    process_batch(batch, readings, scheduler);
+    return;
+  }
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::ProcessBatch, batch.number_of_particles());
+  const BatchStagePlan plan = prepare_batch(batch, readings);
+  detect_batch_particles(batch, plan, 0, batch.number_of_particles());
+}
+
+void Detector::process_batch(const ParticleBatch& batch, ReadingsBatch& readings,
+  WorkStealingScheduler& scheduler) const
+{
+  if(batch.event_offsets.back() != batch.number_of_particles()) {throw std::logic_error(
+    "Error: Batch contains particles outside a closed event. Call end_event() before processing.");}
+  process_batch(batch.view(), readings, scheduler);
+}
+
+// Function to detect the particles of a batch view on the workers of a scheduler:
+// - The tasks are ranges of particles rather than of events, so a batch of many small events
+//   and a batch holding one event with thousands of particles are both split into tasks of
+//   about particles_per_task particles
+// - Idle workers steal the largest untouched range from a busy one, so all workers keep going
+//   until the last task is done instead of waiting for the range with the biggest events
+// - Every task writes a disjoint slice of the readings columns
+void Detector::process_batch(const ParticleBatchView& batch, ReadingsBatch& readings,
+  WorkStealingScheduler& scheduler) const
+{
+  // A few detection chunks per task: enough work to hide the cost of a steal, small enough to
+  // split a large event between workers
+  constexpr std::size_t particles_per_task = 1024;
+  const std::size_t number_of_particles = batch.number_of_particles();
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::ProcessBatch, number_of_particles);
+  const BatchStagePlan plan = prepare_batch(batch, readings);
+  scheduler.parallel_for(0, number_of_particles, particles_per_task,
+    [&](std::size_t first_particle, std::size_t last_particle)
     {
-      // Set the flag based on the sub-detector name
-      if(type == "Tracker") detected_by_tracker = true;
-      else if(type == "EM Calorimeter") detected_by_em_calorimeter = true;
-      else if(type == "Hadronic Calorimeter") detected_by_hadronic_calorimeter = true;
-      else if(type == "Muon Spectrometer") detected_by_muon_spectrometer = true;
-    }
+      detect_batch_particles(batch, plan, first_particle, last_particle);
+    });
+}
+
+// Function to check that the detector is on, size the readings columns for a batch and resolve
+// the output column and the detectability bit of each sub-detector once per batch
+Detector::BatchStagePlan Detector::prepare_batch(const ParticleBatchView& batch, ReadingsBatch& readings) const
+{
+  if(detector_status == false) {throw std::invalid_argument(
+    "Error: Detector is switched off. Cannot detect particles. Exiting program.");}
+  readings.resize(batch.number_of_particles());
+  BatchStagePlan plan;
+  for(const auto& sub_detector : sub_detectors)
+  {
+    plan.columns.push_back(&readings.get_column(sub_detector->get_sub_detector_type_id()));
+    plan.detector_bits.push_back(sub_detector_bit(sub_detector->get_sub_detector_type_id()));
   }
+  return plan;
+}
 
-  // Encode the detection pattern using a 4-bit bitmask
-  // Each bit corresponds to a sub-detector: 
-  // For example, bitmask = 0b0011 means Tracker + EM Calorimeter were triggered
-  int bitmask = 0;
-  if(detected_by_tracker) {bitmask |= 1;}  // 0001
-  if(detected_by_em_calorimeter) {bitmask |= 2;}  // 0010
-  if(detected_by_hadronic_calorimeter) {bitmask |= 4;}  // 0100
-  if(detected_by_muon_spectrometer) {bitmask |= 8;}  // 1000
-  // Use the bitmask to identify the particle based on known interaction signatures
-  switch (bitmask)
+// Function to pass a contiguous range of batch particles through the chain of sub-detectors.
+// The range may start and end in the middle of an event. Only reads the (shared) sub-detector
+// configuration and writes to the range's own slice.
+// The particles are processed in fixed-size chunks, one sub-detector stage at a time:
+// - stages that no particle of the chunk interacts with are skipped (their readings are zero)
+// - the detectable particles of the chunk are gathered into contiguous scratch arrays
+// - one random draw is generated per detectable particle (skipped for perfect resolution)
+// - the batch smearing kernel measures the whole gathered array at once
+// - the measured energies are scattered back and update each particle's remaining energy
+void Detector::detect_batch_particles(const ParticleBatchView& batch, const BatchStagePlan& plan,
+  std::size_t first_particle, std::size_t last_particle) const
+{
+  // Chunk size chosen so that the scratch arrays stay in the L1 cache
+  constexpr std::size_t chunk_size = 256;
+  std::array<double, chunk_size> remaining_energy;
+  std::array<std::uint64_t, chunk_size> event_number;
+  std::array<std::uint32_t, chunk_size> particle_index;
+  std::array<std::uint8_t, chunk_size> detectability;
+  std::array<std::uint32_t, chunk_size> gathered_index;
+  std::array<double, chunk_size> gathered_energy;
+  std::array<double, chunk_size> gathered_draw;
+  const std::size_t number_of_stages = sub_detectors.size();
+  const std::size_t range_end = last_particle;
+  if(first_particle >= last_particle) {return;}
+  // Event of the first particle: the last event starting at or before it (skips empty events)
+  std::size_t event = static_cast<std::size_t>(std::upper_bound(batch.event_offsets,
+    batch.event_offsets + batch.number_of_events() + 1, first_particle) - batch.event_offsets) - 1;
+  for(std::size_t chunk_start = first_particle; chunk_start < range_end;
+    chunk_start += chunk_size)
   {
-    case 0b0010: return "Photon"; // EM Calorimeter only
-    case 0b0011: return "Electron or Positron"; // Tracker + EM Calorimeter
-    case 0b0101: return "Hadron"; // Tracker + Hadronic Calorimeter
-    case 0b1001: return "Muon"; // Tracker + Muon Spectrometer
-    case 0b0000: return "Nothing Detected (Possible Neutrino)"; // No sub-detector triggered
-    default: return "Unknown"; // Any other pattern not explicitly handled
+    const std::size_t chunk_length = std::min(chunk_size, range_end - chunk_start);
+    // Record the coordinates of every particle in the chunk (chunks may span several events),
+    // and collect the sub-detectors that any particle of the chunk interacts with
+    std::uint8_t chunk_detectability = 0;
+    for(std::size_t k = 0; k < chunk_length; ++k)
+    {
+      const std::size_t i = chunk_start + k;
+      while(batch.event_offsets[event + 1] <= i) {++event;}
+      remaining_energy[k] = batch.energy[i];
+      event_number[k] = batch.first_event_number + event;
+      particle_index[k] = static_cast<std::uint32_t>(i - batch.event_offsets[event]);
+      detectability[k] = detectability_mask(batch.type[i]);
+      chunk_detectability |= detectability[k];
+    }
+    for(std::size_t stage = 0; stage < number_of_stages; ++stage)
+    {
+      const SubDetector& sub_detector = *sub_detectors[stage];
+      const std::uint8_t detector_bit = plan.detector_bits[stage];
+      double* column = plan.columns[stage]->data() + chunk_start;
+      if((chunk_detectability & detector_bit) == 0)
+      {
+        std::fill(column, column + chunk_length, 0.0);
+        continue;
+      }
+      // Gather the particles this sub-detector can detect; the rest read zero
+      std::size_t number_gathered = 0;
+      for(std::size_t k = 0; k < chunk_length; ++k)
+      {
+        column[k] = 0.0;
+        if(detectability[k] & detector_bit)
+        {
+          gathered_index[number_gathered] = static_cast<std::uint32_t>(k);
+          gathered_energy[number_gathered] = remaining_energy[k];
+          ++number_gathered;
+        }
+      }
+      if(number_gathered == 0) {continue;}
+      DETECTOR_TIME_STAGE(DetectorMetrics::sub_detector_stage(sub_detector.get_sub_detector_type_id()),
+        number_gathered);
+      // Draw one standard normal per gathered particle (not needed for perfect resolution)
+      DetectorRandom::RandomStreamKey stream{run_seed, 0, 0,
+        static_cast<std::uint32_t>(sub_detector.get_sub_detector_type_id())};
+      for(std::size_t g = 0; g < number_gathered; ++g)
+      {
+        if(sub_detector.get_resolution() == 0) {gathered_draw[g] = 0.0; continue;}
+        stream.event_number = event_number[gathered_index[g]];
+        stream.particle_index = particle_index[gathered_index[g]];
+        gathered_draw[g] = DetectorRandom::standard_normal(stream);
+      }
+      sub_detector.measure_energies(gathered_energy.data(), gathered_draw.data(), gathered_energy.data(),
+        number_gathered);
+      // Scatter the measurements back and update the remaining energy
+      for(std::size_t g = 0; g < number_gathered; ++g)
+      {
+        const std::size_t k = gathered_index[g];
+        column[k] = gathered_energy[g];
+        if(gathered_energy[g] != 0.0) {remaining_energy[k] = gathered_energy[g];}
+      }
+    }
   }
 }
 
-// Function to return the detected energy as the final entry in detector readings
-double Detector::get_detected_energy(const std::map<std::string, double>& readings) const
+// Function to compute the event-level quantities of a processed batch without printing:
+// - The invariant mass uses the summed true four-momenta of all particles of the event
+// - The detected transverse momenta are the true ones scaled by detected / true energy,
+//   with the detected energy taken as the last non-zero reading (as in calculate_missing_energy)
+void Detector::summarise_batch(const ParticleBatchView& batch, const ReadingsBatch& readings,
+  EventSummaryBatch& summaries) const
 {
-  // Iterate through the readings in reverse order (from last to first)
-  // The assumption is that the last non-zero energy entry corresponds to the final detection
-  for(auto it = readings.rbegin(); it != readings.rend(); ++it)
+  if(readings.size() != batch.number_of_particles()) {throw std::invalid_argument(
+    "Mismatch between particles and readings in summarise_batch.");}
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::SummariseBatch, readings.size());
+  const std::size_t number_of_events = batch.number_of_events();
+  summaries.resize(number_of_events);
+  for(std::size_t event = 0; event < number_of_events; ++event)
   {
-    // Return the first non-zero energy found in reverse order
-    if(it->second > 0.0) {return it->second;}
+    MissingEnergyAccumulator totals;
+    for(std::uint64_t i = batch.event_offsets[event]; i < batch.event_offsets[event + 1]; ++i)
+    {
+      totals.add_particle(batch.px[i], batch.py[i], batch.pz[i], batch.energy[i],
+        readings.get_readings(i).get_detected_energy());
+    }
+    summaries.event_number[event] = batch.first_event_number + event;
+    summaries.invariant_mass[event] = totals.get_invariant_mass();
+    summaries.true_energy[event] = totals.get_true_energy();
+    summaries.detected_energy[event] = totals.get_detected_energy();
+    summaries.true_met[event] = totals.get_true_met();
+    summaries.detected_met[event] = totals.get_detected_met();
   }
-  // If no non-zero readings are found, return 0 (i.e., no detection)
-  return 0.0;
 }
 
-// Function to update the running totals to calculate MET
-void Detector::update_totals_for_particle(const Particle& particle, double detected_energy,
-  double& true_px, double& true_py, double& true_energy, double& detected_px, double& detected_py,
-   double& detected_energy_sum) const
+// Function to identify a particle based on detector readings.
+// Each sub-detector that recorded energy (energy > 0 means the particle interacted with it)
+// sets its bit of a 4-bit signature; for example 0b0011 means Tracker + EM Calorimeter.
+// The signature is then looked up in the table of known interaction signatures.
+IdentifiedParticle Detector::identify_particle(const DetectorReadings& detector_readings)
 {
-  // Extract the true four-momentum of the particle
-  const auto& momentum = particle.get_momentum();
-  // Accumulate the true momentum components and energy
-  true_px += momentum.get_px();
-  true_py += momentum.get_py();
-  true_energy += momentum.get_energy();
-  // Approximate the detected transverse momenta by scaling the true momenta
-  // using the ratio of detected energy to true energy.
-  // Assumes direction is preserved and only magnitude is reduced by detector response.
-  if(momentum.get_energy() > 0)
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::IdentifyParticle, 1);
+  return identify_signature(detection_signature(detector_readings));
+}
+
+// Function to identify every particle of a readings batch with the column kernel
+void Detector::identify_batch(const ReadingsBatch& readings, std::vector<IdentifiedParticle>& identified)
+{
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::IdentifyBatch, readings.size());
+  identified.resize(readings.size());
+  std::array<const double*, number_of_sub_detector_types> energy_columns;
+  for(std::size_t type = 0; type < number_of_sub_detector_types; ++type)
   {
-    double scale = detected_energy / momentum.get_energy();
-    detected_px += momentum.get_px() * scale;
-    detected_py += momentum.get_py() * scale;
+    energy_columns[type] = readings.energy_columns[type].data();
   }
-  // Add to the total detected energy sum
-  detected_energy_sum += detected_energy;
+  identify_particles(energy_columns, identified.data(), identified.size());
 }
 
 // Function to print the results of the missing transverse energy (MET) calculation
@@ -313,31 +482,33 @@ void Detector::print_missing_energy_results(const std::string& event_name, doubl
   }
 }
 
-// Function to calculate missing transverse energy
-void Detector::calculate_missing_energy(const std::vector<std::unique_ptr<Particle>>& particles,
-  const std::vector<std::map<std::string, double>>& all_readings, const std::string& event_name)
+// Function to calculate missing transverse energy from the particles of an event and their
+// readings (see MissingEnergyAccumulator for streaming the particles in one at a time)
+double Detector::calculate_missing_energy(const ParticleList& particles,
+  const std::pmr::vector<DetectorReadings>& all_readings, const std::string& event_name) const
 {
   // Ensure each particle has a corresponding set of detector readings
   if(particles.size() != all_readings.size()) {throw std::invalid_argument(
     "Mismatch between particles and readings in calculate_missing_energy.");}
-  // Initialise running totals for true and detected quantities
-  double true_total_px = 0.0, true_total_py = 0.0, true_total_energy = 0.0;
-  double detected_total_px = 0.0, detected_total_py = 0.0, detected_total_energy = 0.0;
-  // Loop over each particle and update the totals using its corresponding detector readings
-  for(size_t i = 0; i < particles.size(); ++i)
-  {
-    const auto& particle = particles[i];
-    // Get the detected energy from the sub-detectors for this particle
-    double detected_energy = get_detected_energy(all_readings[i]);
-    // Update totals for MET calculation
-    update_totals_for_particle(*particle, detected_energy, true_total_px, true_total_py, true_total_energy,
-      detected_total_px, detected_total_py, detected_total_energy);
-  }
-  // Calculate missing transverse energy as the magnitude of the transverse momentum vector
-  double true_met = std::sqrt(true_total_px * true_total_px + true_total_py * true_total_py);
-  double detected_met = std::sqrt(detected_total_px * detected_total_px + detected_total_py * detected_total_py);
-  // Print the final results for this event
-  print_missing_energy_results(event_name, true_total_energy, detected_total_energy, true_met, detected_met);
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::MissingEnergy, particles.size());
+  MissingEnergyAccumulator totals;
+  for(std::size_t i = 0; i < particles.size(); ++i) {totals.add_particle(*particles[i], all_readings[i]);}
+  const double detected_met = totals.get_detected_met();
+  print_missing_energy_results(event_name, totals.get_true_energy(), totals.get_detected_energy(),
+    totals.get_true_met(), detected_met);
+  return detected_met;
+}
+
+// Function to print the missing transverse energy of an event whose particles have been
+// added to the accumulator as they were detected
+double Detector::calculate_missing_energy(const MissingEnergyAccumulator& totals,
+  const std::string& event_name) const
+{
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::MissingEnergy, totals.get_number_of_particles());
+  const double detected_met = totals.get_detected_met();
+  print_missing_energy_results(event_name, totals.get_true_energy(), totals.get_detected_energy(),
+    totals.get_true_met(), detected_met);
+  return detected_met;
 }
 
 // Function to print the detection results for a given particle:
@@ -345,8 +516,8 @@ void Detector::calculate_missing_energy(const std::vector<std::unique_ptr<Partic
 // - Displays detector energy readings in a specific order
 // - Computes and prints total detected energy
 // - Shows which particle the system identified this as
-void Detector::print_detection_results(const Particle& particle, const std::map<std::string, double>& readings,
-  const std::string& identified_as) const
+void Detector::print_detection_results(const Particle& particle, const DetectorReadings& readings,
+  IdentifiedParticle identified_as) const
 {
   double true_energy = particle.get_momentum().get_energy();
   double detected_energy = 0.0;
@@ -363,49 +534,62 @@ void Detector::print_detection_results(const Particle& particle, const std::map<
   std::cout<<"  - Pseudorapidity: "<<momentum.calculate_pseudorapidity()<<std::endl;
 
   std::cout<<"\nDetector energy readings:"<<std::endl;
-  // Iterate through detector subsystems in order and print each energy reading, if available
-  const std::vector<std::string> order = {"Tracker", "EM Calorimeter", "Hadronic Calorimeter", "Muon Spectrometer"};
-  for(const auto& key : order)
+  // Iterate through detector subsystems in detection order and print each energy reading
+  for(std::size_t slot = 0; slot < number_of_sub_detector_types; ++slot)
   {
-    if(readings.count(key))
-    {
-      std::cout<<"  - "<<key<<": "<<readings.at(key)<<" GeV"<<std::endl;
-      detected_energy += readings.at(key);
-    }
+    const auto type = static_cast<SubDetectorType>(slot);
+    std::cout<<"  - "<<sub_detector_type_name(type)<<": "<<readings[type]<<" GeV"<<std::endl;
+    detected_energy += readings[type];
   }
   // Output the particle type this was classified as, based on detection signatures
-  std::cout<<"Identified as: "<<identified_as<<std::endl;
+  std::cout<<"Identified as: "<<identified_particle_name(identified_as)<<std::endl;
 }
 
 // Function to calculate the invariant mass of a system of particles:
 // - Requires at least two particles to be meaningful
-// - Extracts FourMomentum objects from the given particle list
+// - Extracts FourMomentum objects from the given particle list into a buffer taken from
+//   the given memory resource (the event's arena, so no heap allocation is made)
 // - Computes and prints the invariant mass of the full system
-// - Matches the result to known particle masses for Higgs, Z, and top quark decays
-void Detector::calculate_invariant_mass(const std::vector<std::unique_ptr<Particle>>& particles,
-  const std::string& event_name) const
+// - Compares the result with the resonance window the event is expected to come from
+//   (see ResonanceScan.h), so only the event's own resonance can be reported
+double Detector::calculate_invariant_mass(const ParticleList& particles, const std::string& event_name,
+  const std::string& expected_resonance, std::pmr::memory_resource* resource) const
 {
   // Ensure at least two particles are in the vector
   if(particles.size() < 2) {throw std::invalid_argument(
     "Need at least two particles to calculate invariant mass. Exiting program.");}
+  DETECTOR_TIME_STAGE(DetectorMetrics::Stage::InvariantMass, particles.size());
   // Extract momenta from each particle to build the system
-  std::vector<ParticleProperties::FourMomentum> momenta;
+  std::pmr::vector<ParticleProperties::FourMomentum> momenta(resource);
+  momenta.reserve(particles.size());
   for(const auto& particle : particles)
   {
     momenta.push_back(particle->get_momentum());
   }
   // Calculate system invariant mass using FourMomentum static method
-  double invariant_mass = ParticleProperties::FourMomentum::calculate_system_invariant_mass(momenta);
+  double invariant_mass = ParticleProperties::FourMomentum::calculate_system_invariant_mass(
+    momenta.data(), momenta.size());
   // Output results, and provide interpretation if consistent with known particles
   std::cout<<"\n=== [Invariant Mass Calculation for " << event_name << "] ==="<<std::endl;
   std::cout<<"Invariant mass of the system: " << invariant_mass << " GeV"<<std::endl;
   
-  // Display additional information for known particles
-  if(event_name == "Higgs Decay" && std::abs(invariant_mass - 125.0) < 10.0) {std::cout<<
-    "This is consistent with the Higgs boson mass (~125 GeV)."<<std::endl;}
-  else if(event_name == "Z Boson Decay" && std::abs(invariant_mass - 91.2) < 5.0) {std::cout<<
-    "This is consistent with the Z boson mass (~91.2 GeV)."<<std::endl;}
-  else if(event_name == "Anti-Top Quark Decay" && std::abs(invariant_mass - 173.0) < 10.0) {std::cout<<
-    "This is consistent with the top quark mass (~173 GeV)."<<std::endl;}
+  // Display additional information if the mass is inside the expected resonance window
+  if(expected_resonance.empty()) {return invariant_mass;}
+  const std::size_t w = resonance_scanner.find_window(expected_resonance);
+  if(resonance_scanner.window_contains(w, invariant_mass))
+  {
+    const ResonanceWindow& window = resonance_scanner.get_windows()[w];
+    // Nominal masses are printed as written in the table, independent of the stream precision
+    std::ostringstream nominal_mass;
+    nominal_mass<<window.mass;
+    std::cout<<"This is consistent with the "<<window.name<<" mass (~"<<nominal_mass.str()<<" GeV)."<<std::endl;
+  }
+  return invariant_mass;
+}
+
+// Function to run the resonance scan over a batch (see ResonanceScanner::scan_batch)
+void Detector::scan_resonances(const ParticleBatchView& batch, ResonanceCandidates& candidates) const
+{
+  resonance_scanner.scan_batch(batch, candidates);
 }
 
@@ -19,13 +19,24 @@
 #ifndef DETECTOR_H
 #define DETECTOR_H
 
+#include<array>
 #include<vector>
+#include<cstdint>
 #include<memory>
+#include<memory_resource>
 #include<string>
-#include<map>
 
 #include "SubDetector.h"
 #include "Particle.h"
+#include "EventArena.h"
+#include "DetectorReadings.h"
+#include "ParticleBatch.h"
+#include "ReadingsBatch.h"
+#include "EventSummaryBatch.h"
+#include "ParticleIdentification.h"
+#include "ResonanceScan.h"
+#include "MissingEnergyAccumulator.h"
+#include "WorkStealingScheduler.h"
 
 using namespace DetectorSubsystems;
 using namespace ParticleSystem;
@@ -41,18 +52,30 @@ namespace ParticleDetector
     // Function to validate detector name
     static bool validate_detector_name(const std::string& name);
     bool detector_status; // true if on, false if off
+    // Seed of the counter-based random streams; together with the event number, particle index
+    // and sub-detector it fully determines every smearing draw
+    std::uint64_t run_seed;
+    // Resonance mass windows matched by calculate_invariant_mass and scan_resonances
+    ResonanceScanner resonance_scanner;
 
-    // Get the detected energy of the particle as the final entry in detector readings
-    // for MET calculation
-    double get_detected_energy(const std::map<std::string, double>& readings) const;
-    // Function to update the total energy of an interaction for calculating MET
-    void update_totals_for_particle(const Particle& particle, double detected_energy, double& true_px,
-     double& true_py, double& true_energy, double& detected_px, double& detected_py,
-      double& detected_energy_sum) const;
     // Function to print the results of missing energy
     void print_missing_energy_results(const std::string& event_name, double true_energy,
      double detected_energy, double true_met, double detected_met) const;
     // Calculate missing transverse energy
+
+    // [BATCH PROCESSING]
+    // Immutable per-batch plan shared by all worker threads: the output column and the
+    // detectability bit (see DetectionCapability.h) of each sub-detector, in detection order
+    struct BatchStagePlan
+    {
+      std::vector<std::vector<double>*> columns;
+      std::vector<std::uint8_t> detector_bits;
+    };
+    // Check the detector is on, size the readings for a batch and build its plan
+    BatchStagePlan prepare_batch(const ParticleBatchView& batch, ReadingsBatch& readings) const;
+    // Detect the particles [first_particle, last_particle) of a batch (ranges may split events)
+    void detect_batch_particles(const ParticleBatchView& batch, const BatchStagePlan& plan,
+      std::size_t first_particle, std::size_t last_particle) const;
       
   public:
     // [RULE OF 5]
@@ -76,12 +99,19 @@ namespace ParticleDetector
     std::string get_detector_name() const {return detector_name;}
     const std::vector<std::unique_ptr<SubDetector>>& get_subdetectors() const {return sub_detectors;}
     bool get_detector_status() const {return detector_status;}
+    std::uint64_t get_run_seed() const {return run_seed;}
+    const ResonanceScanner& get_resonance_scanner() const {return resonance_scanner;}
 
     // [SETTERS]
     // Set the name of the detector - currently only 'ALTAS' or 'CMS' are allowed
     void set_detector_name(std::string name);
     // Set the detector as either off or on.
     void set_detector_status(bool status);
+    // Set the run seed used for all smearing draws, on the object and batch paths alike
+    void set_run_seed(std::uint64_t seed);
+    // Set the resonance windows and the combinations of particles the resonance scan considers
+    void set_resonance_windows(std::vector<ResonanceWindow> windows,
+      const ResonanceScanOptions& options = ResonanceScanOptions());
 
     // [DETECTOR METHODS]
     // Function to add sub-detectors to the detector - only certain sub-detectors are allowed.
@@ -90,19 +120,58 @@ namespace ParticleDetector
     void validate_sub_detector_configuration() const;
     // Print the detector configuration.
     void print_configuration() const;
-    // Detect a particle and return the energy measured by each sub-detector.
-    std::map<std::string, double> detect_particle(const Particle& particle) const;
+    // Detect a particle and return the energy measured by each sub-detector. The smearing
+    // draws are keyed by the event number and the particle's index within its event, so the
+    // readings match those of process_batch for the same particle, whatever the call order.
+    DetectorReadings detect_particle(const Particle& particle, std::uint64_t event_number,
+      std::uint32_t particle_index) const;
+    // Detect every particle of a structure-of-arrays batch in one pass and fill one
+    // readings column per sub-detector (no per-particle allocation or console output).
+    // The particles are shared out over the given number of worker threads (0 = all hardware
+    // threads); the readings do not depend on the number of threads.
+    void process_batch(const ParticleBatch& batch, ReadingsBatch& readings,
+      unsigned int number_of_threads = 1) const;
+    // Same as above for columns held elsewhere, e.g. a block of a memory-mapped event file.
+    // The columns are read in place and are not copied.
+    void process_batch(const ParticleBatchView& batch, ReadingsBatch& readings,
+      unsigned int number_of_threads = 1) const;
+    // Same as above on the workers of a scheduler, which balance events of very different
+    // sizes by stealing ranges of particles from each other; reusing one scheduler for every
+    // batch also avoids starting threads per batch
+    void process_batch(const ParticleBatch& batch, ReadingsBatch& readings, WorkStealingScheduler& scheduler) const;
+    void process_batch(const ParticleBatchView& batch, ReadingsBatch& readings,
+      WorkStealingScheduler& scheduler) const;
+    // Compute the invariant mass, total energies and MET of every event of a processed batch
+    // (same definitions as calculate_invariant_mass and calculate_missing_energy).
+    void summarise_batch(const ParticleBatchView& batch, const ReadingsBatch& readings,
+      EventSummaryBatch& summaries) const;
     // Identify a particle based on detector readings.
-    static std::string identify_particle(const std::map<std::string, double>& detector_readings);
+    static IdentifiedParticle identify_particle(const DetectorReadings& detector_readings);
+    // Identify a particle from its 4-bit detection signature (one bit per SubDetectorType).
+    static IdentifiedParticle identify_particle(std::uint8_t signature) {return identify_signature(signature);}
+    // Identify every particle of a readings batch (one result per particle).
+    static void identify_batch(const ReadingsBatch& readings, std::vector<IdentifiedParticle>& identified);
     // Function to calculate the missing transverse energy (MET) for a system of particles.
-    void calculate_missing_energy(const std::vector<std::unique_ptr<Particle>>& particles,
-      const std::vector<std::map<std::string, double>>& all_readings, const std::string& event_name);
+    // Returns the detected MET in GeV.
+    double calculate_missing_energy(const ParticleList& particles,
+      const std::pmr::vector<DetectorReadings>& all_readings, const std::string& event_name) const;
+    // Print the MET of an event whose particles were streamed into `totals` as they were
+    // detected. Returns the detected MET in GeV.
+    double calculate_missing_energy(const MissingEnergyAccumulator& totals, const std::string& event_name) const;
     // Print detection results.
-    void print_detection_results(const Particle& particle, const std::map<std::string, double>& readings,
-      const std::string& identified_as) const;
+    void print_detection_results(const Particle& particle, const DetectorReadings& readings,
+      IdentifiedParticle identified_as) const;
     // Function to calculate the invariant mass of a system of particles.
-    void calculate_invariant_mass(const std::vector<std::unique_ptr<Particle>>& particles,
-      const std::string& event_name) const;
+    // `expected_resonance` names the resonance window the event is compared with (e.g.
+    // "Z boson"; empty for none); throws if no window has that name.
+    // Temporaries are allocated from `resource`, e.g. the EventArena of the event.
+    // Returns the invariant mass in GeV.
+    double calculate_invariant_mass(const ParticleList& particles, const std::string& event_name,
+      const std::string& expected_resonance,
+      std::pmr::memory_resource* resource = std::pmr::get_default_resource()) const;
+    // Find the pairs (and, if enabled, triplets) of particles of every event of a batch whose
+    // invariant mass falls inside a resonance window, and append them to `candidates`
+    void scan_resonances(const ParticleBatchView& batch, ResonanceCandidates& candidates) const;
   };
 } // namespace ParticleDetector
 
@@ -14,37 +14,90 @@
 
 #include "DetectorConfig.h"
 
+using namespace DetectorSubsystems;
+
 namespace ParticleDetector
 {
   // Configuration for the ATLAS detector system
-  // This method sets up the sub-detectors specific to the ATLAS detector
-  void ATLASConfig::configure(std::vector<std::unique_ptr<DetectorSubsystems::SubDetector>>& sub_detectors)
+  // This method sets up the sub-detectors specific to the ATLAS detector, in detection order
+  void ATLASConfig::configure(std::vector<std::unique_ptr<SubDetector>>& sub_detectors)
+  {
+    add_configured_sub_detector<ATLASConfig, Tracker>(sub_detectors);
+    add_configured_sub_detector<ATLASConfig, EMCalorimeter>(sub_detectors);
+    add_configured_sub_detector<ATLASConfig, HadronicCalorimeter>(sub_detectors);
+    add_configured_sub_detector<ATLASConfig, MuonSpectrometer>(sub_detectors);
+  }
+
+  void ATLASConfig::configure(Tracker& tracker)
+  {
+    tracker.set_resolution(2);
+    tracker.set_energy_loss_fraction(0.97);
+    tracker.set_tracker_material("Silicon");
+    tracker.set_number_of_subsystems(3);
+  }
+
+  void ATLASConfig::configure(EMCalorimeter& em_calorimeter)
   {
-    add_sub_detector<DetectorSubsystems::Tracker>(sub_detectors, 2, 0.97, "Silicon", 3);
+    em_calorimeter.set_resolution(2);
+    em_calorimeter.set_energy_loss_fraction(0.95);
+    em_calorimeter.set_calorimeter_layers(3);
     // Using std::list to allow for easy addition of materials
-    std::list<std::string> em_materials = {"LAr", "W", "Pb"};
-    add_sub_detector<DetectorSubsystems::EMCalorimeter>(sub_detectors, 2, 0.95, 3, em_materials);
-    
-    std::list<std::string> hadronic_materials = {"Steel", "PST"};
-    add_sub_detector<DetectorSubsystems::HadronicCalorimeter>(sub_detectors, 5, 0.80, 3, hadronic_materials);
-    
-    std::list<std::string> chambers = {"MDT", "RPC", "TGC", "CSC"};
-    add_sub_detector<DetectorSubsystems::MuonSpectrometer>(sub_detectors, 9, 0.95, chambers);
+    em_calorimeter.set_em_cal_materials({"LAr", "W", "Pb"});
+  }
+
+  void ATLASConfig::configure(HadronicCalorimeter& hadronic_calorimeter)
+  {
+    hadronic_calorimeter.set_resolution(5);
+    hadronic_calorimeter.set_energy_loss_fraction(0.80);
+    hadronic_calorimeter.set_calorimeter_layers(3);
+    hadronic_calorimeter.set_hadronic_cal_materials({"Steel", "PST"});
+  }
+
+  void ATLASConfig::configure(MuonSpectrometer& muon_spectrometer)
+  {
+    muon_spectrometer.set_resolution(9);
+    muon_spectrometer.set_energy_loss_fraction(0.95);
+    muon_spectrometer.set_chamber_types({"MDT", "RPC", "TGC", "CSC"});
   }
 
   // Configuration for the CMS detector system
-  // This method sets up the sub-detectors specific to the CMS detector
-  void CMSConfig::configure(std::vector<std::unique_ptr<DetectorSubsystems::SubDetector>>& sub_detectors)
-  {
-    add_sub_detector<DetectorSubsystems::Tracker>(sub_detectors, 2, 0.98, "Silicon", 4);
-    
-    std::list<std::string> em_materials = {"PbWO4"};
-    add_sub_detector<DetectorSubsystems::EMCalorimeter>(sub_detectors, 3, 0.96, 4, em_materials);
-    
-    std::list<std::string> hadronic_materials = {"Brass", "PST"};
-    add_sub_detector<DetectorSubsystems::HadronicCalorimeter>(sub_detectors, 6, 0.85, 4, hadronic_materials);
-    
-    std::list<std::string> chambers = {"MDT", "CSC", "RPC"};
-    add_sub_detector<DetectorSubsystems::MuonSpectrometer>(sub_detectors, 10, 0.96, chambers);
-  }
-} // namespace ParticleDetector
\ No newline at end of file
+  // This method sets up the sub-detectors specific to the CMS detector, in detection order
+  void CMSConfig::configure(std::vector<std::unique_ptr<SubDetector>>& sub_detectors)
+  {
+    add_configured_sub_detector<CMSConfig, Tracker>(sub_detectors);
+    add_configured_sub_detector<CMSConfig, EMCalorimeter>(sub_detectors);
+    add_configured_sub_detector<CMSConfig, HadronicCalorimeter>(sub_detectors);
+    add_configured_sub_detector<CMSConfig, MuonSpectrometer>(sub_detectors);
+  }
+
+  void CMSConfig::configure(Tracker& tracker)
+  {
+    tracker.set_resolution(2);
+    tracker.set_energy_loss_fraction(0.98);
+    tracker.set_tracker_material("Silicon");
+    tracker.set_number_of_subsystems(4);
+  }
+
+  void CMSConfig::configure(EMCalorimeter& em_calorimeter)
+  {
+    em_calorimeter.set_resolution(3);
+    em_calorimeter.set_energy_loss_fraction(0.96);
+    em_calorimeter.set_calorimeter_layers(4);
+    em_calorimeter.set_em_cal_materials({"PbWO4"});
+  }
+
+  void CMSConfig::configure(HadronicCalorimeter& hadronic_calorimeter)
+  {
+    hadronic_calorimeter.set_resolution(6);
+    hadronic_calorimeter.set_energy_loss_fraction(0.85);
+    hadronic_calorimeter.set_calorimeter_layers(4);
+    hadronic_calorimeter.set_hadronic_cal_materials({"Brass", "PST"});
+  }
+
+  void CMSConfig::configure(MuonSpectrometer& muon_spectrometer)
+  {
+    muon_spectrometer.set_resolution(10);
+    muon_spectrometer.set_energy_loss_fraction(0.96);
+    muon_spectrometer.set_chamber_types({"MDT", "CSC", "RPC"});
+  }
+} // namespace ParticleDetector
@@ -7,6 +7,8 @@
 // This file includes the declaration of configuration classes for different detector systems
 // (e.g., ATLAS, CMS) and provides functionality to add sub-detectors to a detector configuration.
 // It also contains a template function to configure detectors with varying setups.
+// Each configuration sets up the sub-detectors one type at a time, so the same settings
+// are used by the run-time Detector and the compile-time StaticDetector.
 //
 // This class structure is useful because it allows for modular configuration of various
 // detector systems.
@@ -42,6 +44,16 @@ namespace ParticleDetector
     sub_detectors.emplace_back(std::make_unique<T>(std::forward<Args>(args)...));
   }
 
+  // Template function to add a default-constructed sub-detector and apply a configuration's
+  // settings for that sub-detector type to it
+  template<typename Config, typename T>
+  void add_configured_sub_detector(std::vector<std::unique_ptr<DetectorSubsystems::SubDetector>>& sub_detectors)
+  {
+    auto sub_detector = std::make_unique<T>();
+    Config::configure(*sub_detector);
+    sub_detectors.emplace_back(std::move(sub_detector));
+  }
+
   // Base configuration class for the detector
   // This class provides a static method for configuring sub-detectors, which can be overridden in derived classes.
   struct DetectorConfig
@@ -54,6 +66,11 @@ namespace ParticleDetector
   struct ATLASConfig : DetectorConfig
   {
     static void configure(std::vector<std::unique_ptr<DetectorSubsystems::SubDetector>>& sub_detectors);
+    // Settings of each sub-detector type
+    static void configure(DetectorSubsystems::Tracker& tracker);
+    static void configure(DetectorSubsystems::EMCalorimeter& em_calorimeter);
+    static void configure(DetectorSubsystems::HadronicCalorimeter& hadronic_calorimeter);
+    static void configure(DetectorSubsystems::MuonSpectrometer& muon_spectrometer);
   };
 
   // CMS-specific configuration class
@@ -61,6 +78,11 @@ namespace ParticleDetector
   struct CMSConfig : DetectorConfig
   {
     static void configure(std::vector<std::unique_ptr<DetectorSubsystems::SubDetector>>& sub_detectors);
+    // Settings of each sub-detector type
+    static void configure(DetectorSubsystems::Tracker& tracker);
+    static void configure(DetectorSubsystems::EMCalorimeter& em_calorimeter);
+    static void configure(DetectorSubsystems::HadronicCalorimeter& hadronic_calorimeter);
+    static void configure(DetectorSubsystems::MuonSpectrometer& muon_spectrometer);
   };
 
   // Template function to configure a detector using a specific configuration class
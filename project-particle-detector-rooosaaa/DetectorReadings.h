@@ -0,0 +1,54 @@
+// DetectorReadings.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `DetectorReadings` structure, which holds the energy measured
+// by each sub-detector for a single particle. The readings are stored in a fixed-size array
+// indexed by `SubDetectorType`, so a set of readings lives inline wherever it is stored
+// (on the stack, or inside the caller's vector) and never touches the heap.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef DETECTOR_READINGS_H
+#define DETECTOR_READINGS_H
+
+#include<array>
+#include<cstddef>
+
+#include "SubDetectorType.h"
+
+namespace ParticleDetector
+{
+  struct DetectorReadings
+  {
+    // Energy in GeV recorded by each sub-detector (0 if the particle was not detected)
+    std::array<double, DetectorSubsystems::number_of_sub_detector_types> energies{};
+
+    // [ACCESS]
+    double& operator[](DetectorSubsystems::SubDetectorType type)
+    {
+      return energies[static_cast<std::size_t>(type)];
+    }
+    double operator[](DetectorSubsystems::SubDetectorType type) const
+    {
+      return energies[static_cast<std::size_t>(type)];
+    }
+
+    // [METHODS]
+    // Detected energy of the particle, taken as the last non-zero reading in detection order
+    // (the sub-detector where it was finally stopped); 0 if nothing was detected
+    double get_detected_energy() const
+    {
+      for(auto it = energies.rbegin(); it != energies.rend(); ++it)
+      {
+        if(*it > 0.0) {return *it;}
+      }
+      return 0.0;
+    }
+  };
+} // namespace ParticleDetector
+
+#endif // DETECTOR_READINGS_H
@@ -19,6 +19,7 @@
 #include<climits>  // For INT_MAX
 
 #include "EMCalorimeter.h"
+#include "Logging.h"
 
 using namespace DetectorSubsystems;
 
@@ -26,7 +27,7 @@ using namespace DetectorSubsystems;
 
 EMCalorimeter::EMCalorimeter() : Calorimeter("EM Calorimeter", 0, 1, 3)
 {
-  std::cout<<"Calling EMCalorimeter class default constructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling EMCalorimeter class default constructor.");
   // Using a list so that we can easily add or remove materials
   std::list<std::string> materials = {"LAr", "W", "Pb"};
   set_em_cal_materials(materials);
@@ -36,12 +37,12 @@ EMCalorimeter::EMCalorimeter(int resolution, double energy_loss, int layers, std
   : Calorimeter("EM Calorimeter", resolution, energy_loss, layers)
 {
   set_em_cal_materials(materials);
-  // The SubDetector base class contructor seeds the random generator and validates the resolution
+  // The SubDetector base class contructor seeds the random stream and validates the resolution
 }
 
 EMCalorimeter::~EMCalorimeter()
 {
-  std::cout<<"Calling EMCalorimeter class destructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling EMCalorimeter class destructor.");
 }
 
 // [SETTERS]
@@ -10,7 +10,7 @@
 // Key functionalities of this class include:
 // - Rule of 5 implementation for proper resource management
 // - Setter methods for validating and setting electron-specific properties (charge and name)
-// - Methods for printing electron information and checking detector compatibility
+// - Methods for printing electron information
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -19,6 +19,7 @@
 #include<iostream>
 
 #include "Electron.h"
+#include "Logging.h"
 
 using namespace ParticleSystem;
 
@@ -31,12 +32,12 @@ Electron::Electron(int id, const FourMomentum& momentum) : Particle("Electron",
 
 Electron::~Electron()
 {
-  std::cout<<"Electron destructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Electron destructor called.");
 }
 
 Electron::Electron(const Electron& other) : Particle(other)
 {
-  std::cout<<"Electron copy constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Electron copy constructor called.");
   // Copy the electron properties
   particle_name = other.particle_name;
   particle_four_momentum = other.particle_four_momentum;
@@ -46,7 +47,7 @@ Electron::Electron(const Electron& other) : Particle(other)
 
 Electron::Electron(Electron&& other) noexcept : Particle(std::move(other))
 {
-  std::cout<<"Electron move constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Electron move constructor called.");
   // Move the electron properties
   particle_name = std::move(other.particle_name);
   // Call move assignment operator for FourMomentum
@@ -60,7 +61,7 @@ Electron::Electron(Electron&& other) noexcept : Particle(std::move(other))
 
 Electron& Electron::operator=(const Electron& other)
 {
-  std::cout<<"Electron copy assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Electron copy assignment operator called.");
   if(this != &other)
   {
     // Copy the electron properties
@@ -74,7 +75,7 @@ Electron& Electron::operator=(const Electron& other)
 
 Electron& Electron::operator=(Electron&& other) noexcept
 {
-  std::cout<<"Electron move assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Electron move assignment operator called.");
   if(this != &other)
   {
     // Move the electron properties
@@ -114,11 +115,3 @@ void Electron::print() const
   std::cout<<"ID: "<<particle_id<<std::endl;
   std::cout<<"Charge (e): "<<particle_charge<<std::endl;
 }
-
-// Detection method
-bool Electron::can_be_detected_by(const std::string& detector_type) const
-{
-  // Check if the electron can be detected by the given detector type
-  if(detector_type == "EM Calorimeter" || detector_type == "Tracker") {return true;}
-  else {return false;}
-}
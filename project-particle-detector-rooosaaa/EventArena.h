@@ -0,0 +1,95 @@
+// EventArena.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `EventArena` class, a per-event memory arena for the
+// particles, readings and temporary buffers of one physics event. It wraps a
+// std::pmr::monotonic_buffer_resource: allocations are taken from a reusable block by
+// bumping a pointer, individual frees do nothing, and all of the event's memory is given
+// back at once by `reset()` at the end of the event. After the first event the arena
+// reuses its initial block, so a steady run makes no calls to malloc or free at all.
+//
+// Particles created in an arena are owned by a `ParticlePtr` (see ParticlePtr.h); releasing
+// one only runs its destructor, as the memory is given back by the arena's reset. They are
+// collected in a `ParticleList` allocated from the same arena. Every object allocated from
+// the arena must be destroyed before the arena is reset.
+//
+// Example:
+//   EventArena arena;
+//   ParticleList particles = arena.make_particle_list();
+//   particles.push_back(arena.make_particle<Photon>(1, FourMomentum(30.0, 25.0, 0.0, 60.0)));
+//   ...
+//   particles.clear();
+//   arena.reset();
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef EVENT_ARENA_H
+#define EVENT_ARENA_H
+
+#include<cstddef>
+#include<memory>
+#include<memory_resource>
+#include<new>
+#include<type_traits>
+#include<utility>
+
+#include "Particle.h"
+#include "ParticlePtr.h"
+
+namespace ParticleSystem
+{
+  class EventArena : public ParticleStorage
+  {
+  private:
+    std::unique_ptr<std::byte[]> initial_block; // reused by every event
+    std::pmr::monotonic_buffer_resource resource;
+
+  public:
+    // Default size of the initial block; enough for the particles of a typical event
+    static constexpr std::size_t default_block_size = 1 << 16;
+
+    // [RULE OF 5]
+    // Parameterised constructor: allocates the initial block once. Events that need more
+    // memory than this get extra blocks from the heap until the next reset.
+    explicit EventArena(std::size_t block_size = default_block_size) :
+      initial_block{std::make_unique<std::byte[]>(block_size)},
+      resource{initial_block.get(), block_size, std::pmr::new_delete_resource()} {}
+    // Not allowing copy or move operations as objects in the arena point into its memory
+    // Copy constructor
+    EventArena(const EventArena& other) = delete;
+    // Move constructor
+    EventArena(EventArena&& other) = delete;
+    // Copy assignment operator
+    EventArena& operator=(const EventArena& other) = delete;
+    // Move assignment operator
+    EventArena& operator=(EventArena&& other) = delete;
+    // Destructor
+    ~EventArena() = default;
+
+    // [GETTERS]
+    // Memory resource for containers of the event, e.g. std::pmr::vector<DetectorReadings>
+    std::pmr::memory_resource* get_resource() {return &resource;}
+
+    // [METHODS]
+    // Construct a particle of type T in the arena
+    template<typename T, typename... Args> ParticlePtr make_particle(Args&&... args)
+    {
+      static_assert(std::is_base_of_v<Particle, T>, "Only particles can be made with make_particle");
+      void* memory = resource.allocate(sizeof(T), alignof(T));
+      return ParticlePtr(new(memory) T(std::forward<Args>(args)...), ParticleDeleter{this});
+    }
+    // Destroy a particle made by make_particle; its memory is reclaimed by the next reset
+    void release(Particle* particle) override {particle->~Particle();}
+    // Create an empty particle list that allocates from the arena
+    ParticleList make_particle_list() {return ParticleList(&resource);}
+    // Release all of the event's memory at once (every object in the arena must have been
+    // destroyed); the initial block is kept for the next event
+    void reset() {resource.release();}
+  };
+} // namespace ParticleSystem
+
+#endif // EVENT_ARENA_H
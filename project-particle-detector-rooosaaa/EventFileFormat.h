@@ -0,0 +1,104 @@
+// EventFileFormat.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the layout of the binary event file format, shared by the
+// EventFileWriter and the memory-mapped EventFileReader. The file stores the same columns
+// as a ParticleBatch, so a block can be handed to `Detector::process_batch` in place:
+//
+//   File header (64 bytes)
+//   Block 0: block header (64 bytes)
+//            event offsets  (number_of_events + 1) x uint64, first entry 0
+//            type codes     number_of_particles x uint8 (ParticleType)
+//            px, py, pz     number_of_particles x double each, in GeV
+//            energy         number_of_particles x double, in GeV
+//            charge         number_of_particles x double, in units of e
+//   Block 1: ...
+//
+// Every section starts on a 64-byte boundary (zero padded), so with a page-aligned mapping
+// every column is aligned for vector loads. Values are stored in the byte order of the
+// machine that wrote the file; the header records it and the reader rejects foreign files.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef EVENT_FILE_FORMAT_H
+#define EVENT_FILE_FORMAT_H
+
+#include<cstddef>
+#include<cstdint>
+
+namespace ParticleSystem
+{
+  // Identification and version of the format
+  constexpr char event_file_magic[8] = {'P', 'D', 'E', 'V', 'E', 'N', 'T', 'S'};
+  constexpr char event_block_magic[8] = {'P', 'D', 'B', 'L', 'O', 'C', 'K', '\0'};
+  constexpr std::uint32_t event_file_version = 1;
+  // Reads back as a different value if the file was written with the other byte order
+  constexpr std::uint32_t event_file_byte_order_mark = 0x01020304;
+  // Alignment of the file header, block headers and every column
+  constexpr std::size_t event_file_alignment = 64;
+
+  struct EventFileHeader
+  {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order_mark;
+    std::uint64_t number_of_blocks;
+    std::uint64_t number_of_events;
+    std::uint64_t number_of_particles;
+    std::uint64_t reserved[3];
+  };
+
+  struct EventBlockHeader
+  {
+    char magic[8];
+    std::uint64_t first_event_number; // global number of the block's first event
+    std::uint64_t number_of_events;
+    std::uint64_t number_of_particles;
+    std::uint64_t block_size; // bytes from the start of this header to the next block
+    std::uint64_t reserved[3];
+  };
+
+  static_assert(sizeof(EventFileHeader) == event_file_alignment, "File header must fill one aligned section");
+  static_assert(sizeof(EventBlockHeader) == event_file_alignment, "Block header must fill one aligned section");
+
+  // Round a section size up to the format alignment
+  constexpr std::uint64_t padded_section_size(std::uint64_t bytes)
+  {
+    return (bytes + event_file_alignment - 1) / event_file_alignment * event_file_alignment;
+  }
+
+  // Byte offsets of the sections of a block, relative to the start of its header
+  struct EventBlockLayout
+  {
+    std::uint64_t event_offsets;
+    std::uint64_t type;
+    std::uint64_t px;
+    std::uint64_t py;
+    std::uint64_t pz;
+    std::uint64_t energy;
+    std::uint64_t charge;
+    std::uint64_t block_size;
+  };
+
+  // Compute the layout of a block holding the given number of events and particles
+  constexpr EventBlockLayout event_block_layout(std::uint64_t events, std::uint64_t particles)
+  {
+    const std::uint64_t column_size = padded_section_size(particles * sizeof(double));
+    EventBlockLayout layout{};
+    layout.event_offsets = sizeof(EventBlockHeader);
+    layout.type = layout.event_offsets + padded_section_size((events + 1) * sizeof(std::uint64_t));
+    layout.px = layout.type + padded_section_size(particles * sizeof(std::uint8_t));
+    layout.py = layout.px + column_size;
+    layout.pz = layout.py + column_size;
+    layout.energy = layout.pz + column_size;
+    layout.charge = layout.energy + column_size;
+    layout.block_size = layout.charge + column_size;
+    return layout;
+  }
+} // namespace ParticleSystem
+
+#endif // EVENT_FILE_FORMAT_H
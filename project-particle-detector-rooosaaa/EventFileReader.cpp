@@ -0,0 +1,203 @@
+// EventFileReader.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the memory-mapped EventFileReader class. All sizes read from the
+// file are checked against the size of the mapping before any column is accessed, so a
+// truncated or corrupt file results in an exception rather than an out-of-bounds read.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<cerrno>
+#include<cmath>
+#include<cstring>
+#include<stdexcept>
+
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+
+#include "EventFileReader.h"
+#include "FourMomentum.h"
+
+using namespace ParticleSystem;
+
+// [RULE OF 5]
+
+EventFileReader::EventFileReader(const std::string& name) :
+  file_name{name}, mapped_data{nullptr}, mapped_size{0}, file_header{}
+{
+  const int file_descriptor = ::open(file_name.c_str(), O_RDONLY);
+  if(file_descriptor < 0) {throw std::runtime_error(
+    "Error: Cannot open event file " + file_name + ": " + std::strerror(errno));}
+  struct stat file_status;
+  if(::fstat(file_descriptor, &file_status) != 0)
+  {
+    const int error = errno;
+    ::close(file_descriptor);
+    throw std::runtime_error("Error: Cannot read size of event file " + file_name + ": " + std::strerror(error));
+  }
+  mapped_size = static_cast<std::size_t>(file_status.st_size);
+  if(mapped_size < sizeof(EventFileHeader))
+  {
+    ::close(file_descriptor);
+    throw std::runtime_error("Error: Event file " + file_name + " is too short to hold a file header.");
+  }
+  void* mapping = ::mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+  const int error = errno;
+  // The mapping keeps the file open, so the descriptor is no longer needed
+  ::close(file_descriptor);
+  if(mapping == MAP_FAILED) {throw std::runtime_error(
+    "Error: Cannot memory-map event file " + file_name + ": " + std::strerror(error));}
+  mapped_data = static_cast<const unsigned char*>(mapping);
+  // Blocks are normally read front to back, so ask for aggressive read-ahead
+  ::madvise(mapping, mapped_size, MADV_SEQUENTIAL);
+  try {read_headers();}
+  catch(...)
+  {
+    unmap();
+    throw;
+  }
+}
+
+EventFileReader::~EventFileReader()
+{
+  unmap();
+}
+
+// [PRIVATE METHODS]
+
+void EventFileReader::unmap() noexcept
+{
+  if(mapped_data != nullptr)
+  {
+    ::munmap(const_cast<unsigned char*>(mapped_data), mapped_size);
+    mapped_data = nullptr;
+  }
+}
+
+void EventFileReader::read_headers()
+{
+  std::memcpy(&file_header, mapped_data, sizeof(file_header));
+  if(std::memcmp(file_header.magic, event_file_magic, sizeof(event_file_magic)) != 0) {throw std::runtime_error(
+    "Error: " + file_name + " is not a particle detector event file.");}
+  if(file_header.byte_order_mark != event_file_byte_order_mark) {throw std::runtime_error(
+    "Error: Event file " + file_name + " was written with a different byte order.");}
+  if(file_header.version != event_file_version) {throw std::runtime_error(
+    "Error: Event file " + file_name + " has unsupported format version " + std::to_string(file_header.version));}
+  // Walk the block headers and check that every block lies inside the file
+  std::uint64_t position = sizeof(EventFileHeader);
+  std::uint64_t total_events = 0;
+  std::uint64_t total_particles = 0;
+  // Every block has a header, so a larger count cannot fit the file (and must not be reserved)
+  if(file_header.number_of_blocks > (mapped_size - sizeof(EventFileHeader)) / sizeof(EventBlockHeader))
+  {
+    throw std::runtime_error("Error: Event file " + file_name + " is truncated: it cannot hold " +
+      std::to_string(file_header.number_of_blocks) + " blocks.");
+  }
+  block_positions.reserve(file_header.number_of_blocks);
+  for(std::uint64_t block = 0; block < file_header.number_of_blocks; ++block)
+  {
+    if(mapped_size - position < sizeof(EventBlockHeader)) {throw std::runtime_error(
+      "Error: Event file " + file_name + " is truncated in block " + std::to_string(block));}
+    EventBlockHeader block_header;
+    std::memcpy(&block_header, mapped_data + position, sizeof(block_header));
+    if(std::memcmp(block_header.magic, event_block_magic, sizeof(event_block_magic)) != 0) {throw std::runtime_error(
+      "Error: Event file " + file_name + " has a corrupt header in block " + std::to_string(block));}
+    // Guard the layout computation against sizes that would overflow
+    const std::uint64_t maximum_count = mapped_size / sizeof(std::uint64_t);
+    if(block_header.number_of_events >= maximum_count || block_header.number_of_particles >= maximum_count ||
+      block_header.block_size != event_block_layout(block_header.number_of_events,
+        block_header.number_of_particles).block_size || block_header.block_size > mapped_size - position)
+    {
+      throw std::runtime_error("Error: Event file " + file_name + " has inconsistent sizes in block " +
+        std::to_string(block));
+    }
+    block_positions.push_back(position);
+    total_events += block_header.number_of_events;
+    total_particles += block_header.number_of_particles;
+    position += block_header.block_size;
+  }
+  block_validated = std::make_unique<std::atomic<bool>[]>(block_positions.size());
+  if(total_events != file_header.number_of_events || total_particles != file_header.number_of_particles)
+  {
+    throw std::runtime_error("Error: Event file " + file_name + " totals do not match its blocks.");
+  }
+}
+
+// Function to check the columns of a block before the detector reads them:
+// - The event offsets must partition the particles of the block
+// - Type codes are used as table indices, so every code must be a known particle type
+// - Every four-momentum must pass the same check as FourMomentum and ParticleBatch::add_particle
+// - Every charge must be finite, as it decides the pairs of the resonance scan
+void EventFileReader::validate_block(std::size_t block, const ParticleBatchView& view) const
+{
+  const std::uint64_t number_of_particles = get_block_header(block).number_of_particles;
+  // The event offsets must partition the particles of the block
+  if(view.event_offsets[0] != 0 || view.event_offsets[view.events] != number_of_particles)
+  {
+    throw std::runtime_error("Error: Event file " + file_name + " has invalid event offsets in block " +
+      std::to_string(block));
+  }
+  for(std::size_t event = 0; event < view.events; ++event)
+  {
+    if(view.event_offsets[event + 1] < view.event_offsets[event]) {throw std::runtime_error(
+      "Error: Event file " + file_name + " has invalid event offsets in block " + std::to_string(block));}
+  }
+  // Type codes are used as table indices, so every code must be a known particle type
+  const unsigned char* type_codes = reinterpret_cast<const unsigned char*>(view.type);
+  for(std::uint64_t particle = 0; particle < number_of_particles; ++particle)
+  {
+    if(type_codes[particle] >= number_of_particle_types) {throw std::runtime_error(
+      "Error: Event file " + file_name + " has an unknown particle type code in block " + std::to_string(block));}
+  }
+  for(std::uint64_t particle = 0; particle < number_of_particles; ++particle)
+  {
+    if(!ParticleProperties::FourMomentum::validate_components(view.px[particle], view.py[particle],
+      view.pz[particle], view.energy[particle]))
+    {
+      throw std::runtime_error("Error: Event file " + file_name + " has an unphysical four-momentum in block " +
+        std::to_string(block));
+    }
+    if(!std::isfinite(view.charge[particle])) {throw std::runtime_error(
+      "Error: Event file " + file_name + " has a non-finite charge in block " + std::to_string(block));}
+  }
+}
+
+// [GETTERS]
+
+const EventBlockHeader& EventFileReader::get_block_header(std::size_t block) const
+{
+  if(block >= block_positions.size()) {throw std::out_of_range(
+    "Error: Event file " + file_name + " has no block " + std::to_string(block));}
+  // Block headers are 64-byte aligned within the page-aligned mapping
+  return *reinterpret_cast<const EventBlockHeader*>(mapped_data + block_positions[block]);
+}
+
+ParticleBatchView EventFileReader::get_block(std::size_t block) const
+{
+  const EventBlockHeader& block_header = get_block_header(block);
+  const EventBlockLayout layout = event_block_layout(block_header.number_of_events,
+    block_header.number_of_particles);
+  const unsigned char* block_data = mapped_data + block_positions[block];
+  ParticleBatchView view;
+  view.event_offsets = reinterpret_cast<const std::uint64_t*>(block_data + layout.event_offsets);
+  view.type = reinterpret_cast<const ParticleType*>(block_data + layout.type);
+  view.px = reinterpret_cast<const double*>(block_data + layout.px);
+  view.py = reinterpret_cast<const double*>(block_data + layout.py);
+  view.pz = reinterpret_cast<const double*>(block_data + layout.pz);
+  view.energy = reinterpret_cast<const double*>(block_data + layout.energy);
+  view.charge = reinterpret_cast<const double*>(block_data + layout.charge);
+  view.events = static_cast<std::size_t>(block_header.number_of_events);
+  view.first_event_number = block_header.first_event_number;
+  if(!block_validated[block].load(std::memory_order_acquire))
+  {
+    validate_block(block, view);
+    block_validated[block].store(true, std::memory_order_release);
+  }
+  return view;
+}
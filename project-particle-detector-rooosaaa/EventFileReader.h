@@ -0,0 +1,86 @@
+// EventFileReader.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Header file for the EventFileReader class, a zero-copy reader for the binary event file
+// format (see EventFileFormat.h). The whole file is memory-mapped read-only and each block
+// is returned as a ParticleBatchView pointing straight into the mapping, so events can be
+// passed to `Detector::process_batch` without parsing or constructing Particle objects.
+// Pages are loaded by the operating system as the columns are first read.
+//
+// Opening a file only reads the file header and the block headers. The columns of a block
+// are validated the first time the block is requested: the event offsets, the particle type
+// codes, every four-momentum (finite components, E >= 0 and E^2 >= p^2, as checked by
+// FourMomentum) and every charge (finite), so a corrupt file cannot pass NaN or unphysical
+// values to the detector.
+// Later requests for the same block reuse the result without rescanning the columns.
+// Memory mapping uses the POSIX mmap interface.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef EVENT_FILE_READER_H
+#define EVENT_FILE_READER_H
+
+#include<atomic>
+#include<cstddef>
+#include<cstdint>
+#include<memory>
+#include<string>
+#include<vector>
+
+#include "EventFileFormat.h"
+#include "ParticleBatchView.h"
+
+namespace ParticleSystem
+{
+  class EventFileReader
+  {
+  private:
+    std::string file_name;
+    const unsigned char* mapped_data; // start of the read-only mapping
+    std::size_t mapped_size; // size of the mapping (and of the file) in bytes
+    EventFileHeader file_header;
+    std::vector<std::uint64_t> block_positions; // byte position of each block header
+    // Whether each block's columns have been validated; atomic so that several threads can
+    // request blocks at once (a block checked by two threads at the same time is harmless)
+    std::unique_ptr<std::atomic<bool>[]> block_validated;
+    // Read and check the file header and every block header
+    void read_headers();
+    // Check the event offsets, type codes and four-momenta of a block; throws if any is invalid
+    void validate_block(std::size_t block, const ParticleBatchView& view) const;
+    // Release the mapping
+    void unmap() noexcept;
+
+  public:
+    // [RULE OF 5]
+    // Parameterised constructor: maps the file and reads its headers
+    explicit EventFileReader(const std::string& name);
+    // Not allowing copy or move operations as the reader owns the mapping
+    // Copy constructor
+    EventFileReader(const EventFileReader& other) = delete;
+    // Move constructor
+    EventFileReader(EventFileReader&& other) = delete;
+    // Copy assignment operator
+    EventFileReader& operator=(const EventFileReader& other) = delete;
+    // Move assignment operator
+    EventFileReader& operator=(EventFileReader&& other) = delete;
+    // Destructor
+    ~EventFileReader();
+
+    // [GETTERS]
+    const std::string& get_file_name() const {return file_name;}
+    std::size_t number_of_blocks() const {return block_positions.size();}
+    std::uint64_t number_of_events() const {return file_header.number_of_events;}
+    std::uint64_t number_of_particles() const {return file_header.number_of_particles;}
+    // Return the header of a block
+    const EventBlockHeader& get_block_header(std::size_t block) const;
+    // Return a view of the columns of a block; the view stays valid while the reader exists.
+    // Throws if the block's columns are invalid (checked on the first request only).
+    ParticleBatchView get_block(std::size_t block) const;
+  };
+} // namespace ParticleSystem
+
+#endif // EVENT_FILE_READER_H
@@ -0,0 +1,98 @@
+// EventFileWriter.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the EventFileWriter class. Columns are written straight from
+// the batch memory with one write per column, followed by zero padding to the next
+// 64-byte boundary.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<array>
+#include<cstring>
+#include<stdexcept>
+
+#include "EventFileWriter.h"
+
+using namespace ParticleSystem;
+
+// [RULE OF 5]
+
+EventFileWriter::EventFileWriter(const std::string& name) :
+  file_name{name}, output{name, std::ios::binary | std::ios::trunc}, file_header{}
+{
+  if(!output) {throw std::runtime_error("Error: Cannot create event file " + file_name);}
+  std::memcpy(file_header.magic, event_file_magic, sizeof(event_file_magic));
+  file_header.version = event_file_version;
+  file_header.byte_order_mark = event_file_byte_order_mark;
+  // Reserve the header; the totals are only known when the file is closed
+  write_section(&file_header, sizeof(file_header));
+}
+
+EventFileWriter::~EventFileWriter()
+{
+  // Destructors must not throw, so errors while closing are only reported by close() itself
+  try {close();}
+  catch(...) {}
+}
+
+// [PRIVATE METHODS]
+
+void EventFileWriter::write_section(const void* data, std::uint64_t bytes)
+{
+  static const std::array<char, event_file_alignment> zeros{};
+  output.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+  output.write(zeros.data(), static_cast<std::streamsize>(padded_section_size(bytes) - bytes));
+}
+
+// [METHODS]
+
+void EventFileWriter::write_block(const ParticleBatch& batch)
+{
+  // Particles added after the last end_event() must belong to an event
+  if(batch.event_offsets.back() != batch.number_of_particles()) {throw std::logic_error(
+    "Error: Batch contains particles outside a closed event. Call end_event() before writing.");}
+  write_block(batch.view());
+}
+
+void EventFileWriter::write_block(const ParticleBatchView& batch)
+{
+  if(!output.is_open()) {throw std::logic_error("Error: Event file " + file_name + " is already closed.");}
+  const std::uint64_t events = batch.number_of_events();
+  const std::uint64_t particles = batch.number_of_particles();
+  EventBlockHeader block_header{};
+  std::memcpy(block_header.magic, event_block_magic, sizeof(event_block_magic));
+  block_header.first_event_number = batch.first_event_number;
+  block_header.number_of_events = events;
+  block_header.number_of_particles = particles;
+  block_header.block_size = event_block_layout(events, particles).block_size;
+  // Sections in the order given by event_block_layout
+  write_section(&block_header, sizeof(block_header));
+  // An empty view may have no offsets array; its single offset is 0
+  const std::uint64_t no_offsets = 0;
+  write_section(batch.event_offsets != nullptr ? batch.event_offsets : &no_offsets,
+    (events + 1) * sizeof(std::uint64_t));
+  write_section(batch.type, particles * sizeof(ParticleType));
+  write_section(batch.px, particles * sizeof(double));
+  write_section(batch.py, particles * sizeof(double));
+  write_section(batch.pz, particles * sizeof(double));
+  write_section(batch.energy, particles * sizeof(double));
+  write_section(batch.charge, particles * sizeof(double));
+  if(!output) {throw std::runtime_error("Error: Failed to write block to event file " + file_name);}
+  ++file_header.number_of_blocks;
+  file_header.number_of_events += events;
+  file_header.number_of_particles += particles;
+}
+
+void EventFileWriter::close()
+{
+  if(!output.is_open()) {return;}
+  // Fill in the totals at the start of the file
+  output.seekp(0);
+  output.write(reinterpret_cast<const char*>(&file_header), sizeof(file_header));
+  output.close();
+  if(!output) {throw std::runtime_error("Error: Failed to finish event file " + file_name);}
+}
@@ -0,0 +1,70 @@
+// EventFileWriter.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Header file for the EventFileWriter class, which writes particle batches to the binary
+// event file format (see EventFileFormat.h). Each call to `write_block` appends one block
+// holding the closed events of a batch; the file header totals are written by `close`.
+// Files are read back with the memory-mapped EventFileReader.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef EVENT_FILE_WRITER_H
+#define EVENT_FILE_WRITER_H
+
+#include<cstddef>
+#include<cstdint>
+#include<fstream>
+#include<string>
+
+#include "EventFileFormat.h"
+#include "ParticleBatch.h"
+#include "ParticleBatchView.h"
+
+namespace ParticleSystem
+{
+  class EventFileWriter
+  {
+  private:
+    std::string file_name;
+    std::ofstream output;
+    EventFileHeader file_header; // running totals, written to the start of the file by close()
+    // Write raw bytes followed by zero padding up to the format alignment
+    void write_section(const void* data, std::uint64_t bytes);
+
+  public:
+    // [RULE OF 5]
+    // Parameterised constructor: creates (or truncates) the file
+    explicit EventFileWriter(const std::string& name);
+    // Not allowing copy or move operations as the writer owns the open file
+    // Copy constructor
+    EventFileWriter(const EventFileWriter& other) = delete;
+    // Move constructor
+    EventFileWriter(EventFileWriter&& other) = delete;
+    // Copy assignment operator
+    EventFileWriter& operator=(const EventFileWriter& other) = delete;
+    // Move assignment operator
+    EventFileWriter& operator=(EventFileWriter&& other) = delete;
+    // Destructor: closes the file if close() has not been called
+    ~EventFileWriter();
+
+    // [GETTERS]
+    const std::string& get_file_name() const {return file_name;}
+    bool is_open() const {return output.is_open();}
+    std::uint64_t number_of_blocks() const {return file_header.number_of_blocks;}
+    std::uint64_t number_of_events() const {return file_header.number_of_events;}
+    std::uint64_t number_of_particles() const {return file_header.number_of_particles;}
+
+    // [METHODS]
+    // Append the closed events of a batch as one block
+    void write_block(const ParticleBatch& batch);
+    void write_block(const ParticleBatchView& batch);
+    // Write the file header totals and close the file
+    void close();
+  };
+} // namespace ParticleSystem
+
+#endif // EVENT_FILE_WRITER_H
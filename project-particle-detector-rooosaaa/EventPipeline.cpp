@@ -0,0 +1,207 @@
+// EventPipeline.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the EventPipeline class. The batch buffers are passed between the
+// stages as pointers, so a queue operation never copies event data. Every stage worker loops
+// popping a batch from its input queue, processing it and pushing it to its output queue;
+// the last worker of a stage to finish closes the output queue, which lets the next stage
+// drain the remaining batches and finish in turn.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<atomic>
+#include<exception>
+#include<memory>
+#include<mutex>
+#include<stdexcept>
+#include<thread>
+#include<vector>
+
+#include "BoundedQueue.h"
+#include "EventPipeline.h"
+#include "StageTimer.h"
+
+using namespace ParticleDetector;
+
+namespace
+{
+  using BatchQueue = BoundedQueue<PipelineBatch*>;
+
+  std::size_t round_up_to_power_of_two(std::size_t value)
+  {
+    std::size_t power = 2;
+    while(power < value) {power *= 2;}
+    return power;
+  }
+}
+
+// [CONSTRUCTORS]
+
+EventPipeline::EventPipeline(const Detector& pipeline_detector, const PipelineOptions& pipeline_options) :
+  detector{pipeline_detector}, options{pipeline_options}, batches_processed{0}, events_processed{0},
+  particles_processed{0}
+{
+  if(options.generation_threads == 0 || options.identification_threads == 0 || options.analysis_threads == 0)
+  {
+    throw std::invalid_argument("Error: Every pipeline stage needs at least one thread.");
+  }
+  if(options.detection_threads == 0)
+  {
+    // Detection is the most expensive stage, so it gets the hardware threads left over
+    const unsigned int other_threads = options.generation_threads + options.identification_threads +
+      options.analysis_threads;
+    const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    options.detection_threads = hardware_threads > other_threads ? hardware_threads - other_threads : 1;
+  }
+  if(options.batches_in_flight == 0)
+  {
+    options.batches_in_flight = 2 * static_cast<std::size_t>(options.generation_threads + options.detection_threads +
+      options.identification_threads + options.analysis_threads);
+  }
+  options.batches_in_flight = round_up_to_power_of_two(options.batches_in_flight);
+}
+
+// [METHODS]
+
+// Function to run the generator's batches through every stage:
+// - Every batch buffer starts in the free queue; a generation worker takes one, fills it and
+//   passes it on, and the analysis stage returns it to the free queue when it is done
+// - A stage whose input queue is closed and empty finishes, and its last worker closes the
+//   queue of the next stage
+// - The first error closes every queue, so blocked workers wake up and return
+void EventPipeline::run(const Generator& generate, const Analyser& analyse)
+{
+  batches_processed = 0;
+  events_processed = 0;
+  particles_processed = 0;
+  // Every queue can hold all of the buffers, so only the free queue ever makes a stage wait
+  const std::size_t number_of_buffers = options.batches_in_flight;
+  BatchQueue free_batches(number_of_buffers);
+  BatchQueue generated_batches(number_of_buffers);
+  BatchQueue detected_batches(number_of_buffers);
+  BatchQueue identified_batches(number_of_buffers);
+  std::vector<std::unique_ptr<PipelineBatch>> buffers;
+  buffers.reserve(number_of_buffers);
+  for(std::size_t i = 0; i < number_of_buffers; ++i)
+  {
+    buffers.push_back(std::make_unique<PipelineBatch>());
+    buffers.back()->particles.reserve(options.events_per_batch, 8 * options.events_per_batch);
+    free_batches.try_push(buffers.back().get());
+  }
+
+  std::mutex error_mutex;
+  std::exception_ptr first_error;
+  auto fail = [&]
+  {
+    {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if(!first_error) {first_error = std::current_exception();}
+    }
+    free_batches.close();
+    generated_batches.close();
+    detected_batches.close();
+    identified_batches.close();
+  };
+
+  std::atomic<std::uint64_t> next_sequence{0};
+  std::atomic<bool> generation_finished{false};
+  std::atomic<std::uint64_t> batches{0}, events{0}, particles{0};
+
+  // [STAGES]
+  auto generation_stage = [&](std::size_t)
+  {
+    PipelineBatch* batch = nullptr;
+    while(!generation_finished.load(std::memory_order_acquire) && free_batches.pop(batch))
+    {
+      batch->particles.clear();
+      batch->sequence = next_sequence.fetch_add(1, std::memory_order_relaxed);
+#if PARTICLE_DETECTOR_METRICS
+      const std::uint64_t start = DetectorMetrics::read_ticks();
+#endif
+      const bool generated = generate(batch->sequence, batch->particles);
+#if PARTICLE_DETECTOR_METRICS
+      // Counted in particles, like every other stage
+      DetectorMetrics::record(DetectorMetrics::Stage::EventGeneration, DetectorMetrics::read_ticks() - start,
+        batch->particles.number_of_particles());
+#endif
+      if(!generated)
+      {
+        generation_finished.store(true, std::memory_order_release);
+        free_batches.push(batch);
+        return;
+      }
+      if(!generated_batches.push(batch)) {return;}
+    }
+  };
+  auto detection_stage = [&](std::size_t)
+  {
+    PipelineBatch* batch = nullptr;
+    while(generated_batches.pop(batch))
+    {
+      // Batches are already spread over the detection workers, so each uses a single thread
+      detector.process_batch(batch->particles, batch->readings, 1);
+      if(!detected_batches.push(batch)) {return;}
+    }
+  };
+  auto identification_stage = [&](std::size_t)
+  {
+    PipelineBatch* batch = nullptr;
+    while(detected_batches.pop(batch))
+    {
+      Detector::identify_batch(batch->readings, batch->identified);
+      detector.summarise_batch(batch->particles.view(), batch->readings, batch->summaries);
+      if(!identified_batches.push(batch)) {return;}
+    }
+  };
+  auto analysis_stage = [&](std::size_t worker)
+  {
+    PipelineBatch* batch = nullptr;
+    while(identified_batches.pop(batch))
+    {
+      analyse(*batch, worker);
+      batches.fetch_add(1, std::memory_order_relaxed);
+      events.fetch_add(batch->particles.number_of_events(), std::memory_order_relaxed);
+      particles.fetch_add(batch->particles.number_of_particles(), std::memory_order_relaxed);
+      if(!free_batches.push(batch)) {return;}
+    }
+  };
+
+  // [WORKERS]
+  // Workers still running in each stage, in stage order
+  std::atomic<unsigned int> remaining_workers[4] = {{options.generation_threads}, {options.detection_threads},
+    {options.identification_threads}, {options.analysis_threads}};
+  std::vector<std::thread> threads;
+  threads.reserve(options.generation_threads + options.detection_threads + options.identification_threads +
+    options.analysis_threads);
+  auto start_stage = [&](std::size_t stage, unsigned int number_of_workers, BatchQueue& output,
+    const std::function<void(std::size_t)>& process)
+  {
+    for(unsigned int worker = 0; worker < number_of_workers; ++worker)
+    {
+      threads.emplace_back([&, stage, worker, process]
+      {
+        try {process(worker);}
+        catch(...) {fail();}
+        if(remaining_workers[stage].fetch_sub(1, std::memory_order_acq_rel) == 1) {output.close();}
+      });
+    }
+  };
+  try
+  {
+    start_stage(3, options.analysis_threads, free_batches, analysis_stage);
+    start_stage(2, options.identification_threads, identified_batches, identification_stage);
+    start_stage(1, options.detection_threads, detected_batches, detection_stage);
+    start_stage(0, options.generation_threads, generated_batches, generation_stage);
+  }
+  catch(...) {fail();} // a thread could not be started; stop the ones that were
+  for(auto& thread : threads) {thread.join();}
+  if(first_error) {std::rethrow_exception(first_error);}
+  batches_processed = batches.load(std::memory_order_relaxed);
+  events_processed = events.load(std::memory_order_relaxed);
+  particles_processed = particles.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,115 @@
+// EventPipeline.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `EventPipeline` class, which runs the stages of a run
+// (generation -> detection -> identification -> analysis) at the same time instead of one
+// after another. Each stage has its own pool of worker threads, and the stages pass batches
+// of events to each other through lock-free `BoundedQueue`s:
+//
+//   free slots -> generation -> detection -> identification -> analysis -> free slots
+//
+// - generation fills a batch through a user callback (e.g. an LHE reader or an event generator)
+// - detection runs Detector::process_batch on one batch per worker
+// - identification runs Detector::identify_batch and Detector::summarise_batch
+// - analysis hands the finished batch to a user callback (e.g. histogram filling)
+//
+// A fixed number of `PipelineBatch` buffers circulate through the queues and are reused, so
+// a slow stage holds back the stages before it once every buffer is waiting for it
+// (backpressure) and memory use stays bounded however many events are run. Batches can
+// finish out of order; every result is keyed by the global event number, so the readings do
+// not depend on the order or on the number of threads.
+//
+// If any callback or stage throws, every queue is closed, the workers stop, and run()
+// rethrows the first exception.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef EVENT_PIPELINE_H
+#define EVENT_PIPELINE_H
+
+#include<cstddef>
+#include<cstdint>
+#include<functional>
+#include<vector>
+
+#include "Detector.h"
+#include "EventSummaryBatch.h"
+#include "ParticleBatch.h"
+#include "ParticleIdentification.h"
+#include "ReadingsBatch.h"
+
+namespace ParticleDetector
+{
+  // Buffers of one batch of events as it moves through the pipeline
+  struct PipelineBatch
+  {
+    std::uint64_t sequence = 0; // order in which the batch was generated, starting at 0
+    ParticleSystem::ParticleBatch particles; // filled by the generation stage
+    ReadingsBatch readings; // filled by the detection stage
+    std::vector<IdentifiedParticle> identified; // filled by the identification stage
+    EventSummaryBatch summaries; // filled by the identification stage
+  };
+
+  struct PipelineOptions
+  {
+    std::size_t events_per_batch = 1000; // reserved per batch; the generator decides the actual number
+    unsigned int generation_threads = 1; // more than one requires a thread-safe generator
+    unsigned int detection_threads = 0; // 0 = all hardware threads not used by the other stages
+    unsigned int identification_threads = 1;
+    unsigned int analysis_threads = 1;
+    std::size_t batches_in_flight = 0; // 0 = two per worker thread; rounded up to a power of two
+  };
+
+  class EventPipeline
+  {
+  public:
+    // Fill `particles` with the events of batch number `sequence` (the batch is cleared
+    // beforehand); return false once there are no more events
+    using Generator = std::function<bool(std::uint64_t sequence, ParticleSystem::ParticleBatch& particles)>;
+    // Consume a finished batch; `worker` is the index in [0, analysis_threads) of the calling
+    // analysis thread, e.g. a histogram shard
+    using Analyser = std::function<void(const PipelineBatch& batch, std::size_t worker)>;
+
+  private:
+    const Detector& detector;
+    PipelineOptions options;
+    std::uint64_t batches_processed;
+    std::uint64_t events_processed;
+    std::uint64_t particles_processed;
+
+  public:
+    // [RULE OF 5]
+    // Parameterised constructor; resolves the default thread counts and throws if a stage
+    // has no threads
+    EventPipeline(const Detector& pipeline_detector, const PipelineOptions& pipeline_options = PipelineOptions());
+    // Not allowing copy or move operations as the pipeline refers to its detector
+    // Copy constructor
+    EventPipeline(const EventPipeline& other) = delete;
+    // Move constructor
+    EventPipeline(EventPipeline&& other) = delete;
+    // Copy assignment operator
+    EventPipeline& operator=(const EventPipeline& other) = delete;
+    // Move assignment operator
+    EventPipeline& operator=(EventPipeline&& other) = delete;
+    // Destructor
+    ~EventPipeline() = default;
+
+    // [GETTERS]
+    const PipelineOptions& get_options() const {return options;}
+    // Totals of the last run
+    std::uint64_t get_batches_processed() const {return batches_processed;}
+    std::uint64_t get_events_processed() const {return events_processed;}
+    std::uint64_t get_particles_processed() const {return particles_processed;}
+
+    // [METHODS]
+    // Run every batch of the generator through the stages and return when all of them have
+    // been analysed (or rethrow the first error of any stage)
+    void run(const Generator& generate, const Analyser& analyse);
+  };
+} // namespace ParticleDetector
+
+#endif // EVENT_PIPELINE_H
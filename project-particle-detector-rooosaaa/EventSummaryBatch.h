@@ -0,0 +1,53 @@
+// EventSummaryBatch.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `EventSummaryBatch` structure, which stores the event-level
+// quantities of a processed batch as one column per quantity and one entry per event:
+// the invariant mass of all particles, the true and detected total energy and the true and
+// detected missing transverse energy (MET). It is filled by `Detector::summarise_batch`
+// with the same definitions as `calculate_invariant_mass` and `calculate_missing_energy`.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef EVENT_SUMMARY_BATCH_H
+#define EVENT_SUMMARY_BATCH_H
+
+#include<cstddef>
+#include<cstdint>
+#include<vector>
+
+namespace ParticleDetector
+{
+  struct EventSummaryBatch
+  {
+    // [COLUMNS]
+    // One entry per event, all quantities in GeV
+    std::vector<std::uint64_t> event_number; // global event number
+    std::vector<double> invariant_mass; // invariant mass of the true four-momenta
+    std::vector<double> true_energy; // sum of the true particle energies
+    std::vector<double> detected_energy; // sum of the detected particle energies
+    std::vector<double> true_met; // MET from the true momenta
+    std::vector<double> detected_met; // MET from the momenta scaled by the detected energy
+
+    // [METHODS]
+    // Resize every column to hold the given number of events
+    void resize(std::size_t events)
+    {
+      event_number.resize(events);
+      invariant_mass.resize(events);
+      true_energy.resize(events);
+      detected_energy.resize(events);
+      true_met.resize(events);
+      detected_met.resize(events);
+    }
+
+    // [GETTERS]
+    std::size_t size() const {return event_number.size();}
+  };
+} // namespace ParticleDetector
+
+#endif // EVENT_SUMMARY_BATCH_H
@@ -7,128 +7,25 @@
 // vector (px, py, pz, E) used in particle physics.
 //
 // This implementation includes:
-// - Memory management (constructors, destructors, and assignment operators)
-// - Component setters with validation for physical constraints
-// - Enforcement of relativistic constraints (E² ≥ p², non-negative energy)
-// - Functions to perform several calculations using the four momentum, including
-//   calculating the invariant mass for a system of particles.
+// - The physics calculations on a four-momentum, which use square roots and logarithms,
+//   including the invariant mass of a system of particles (a sum of four-momenta)
+// - Printing of the four-momentum
+// The constructors, validation and arithmetic operators are constexpr and are defined in
+// FourMomentum.h.
 //
 // === COMPILATION AND EXECUTION ===
 //
 // Please see the README file for details on compilation and execution of this program.
 
+#include<numeric>
 #include<vector>
 
 #include "FourMomentum.h"
+#include "KinematicsKernel.h"
 #include "Particle.h"
 
 using namespace ParticleProperties;
 
-// [RULE OF 5]
-
-FourMomentum::FourMomentum() : particle_px(0.0), particle_py(0.0), particle_pz(0.0), particle_energy(0.0)
-{
-  // Initialise four-momentum to zero
-  std::cout<<"FourMomentum default constructor called. Four-momentum initialised to zero."<<std::endl;
-}
-
-FourMomentum::FourMomentum(double px, double py, double pz, double energy)
-{
-  set_momentum_components(px, py, pz, energy);
-}
-
-FourMomentum::FourMomentum(const FourMomentum& other)
-  : particle_px(other.particle_px), particle_py(other.particle_py), particle_pz(other.particle_pz),
-    particle_energy(other.particle_energy) {}
-
-
-FourMomentum::FourMomentum(FourMomentum&& other) noexcept
-  : particle_px(other.particle_px), particle_py(other.particle_py), particle_pz(other.particle_pz),
-    particle_energy(other.particle_energy)
-{
-  // Move four-momentum components
-  other.particle_px = 0.0;
-  other.particle_py = 0.0;
-  other.particle_pz = 0.0;
-  other.particle_energy = 0.0;
-}
-
-FourMomentum::~FourMomentum()
-{
-  //std::cout<<"Four-momentum object destroyed."<<std::endl;
-}
-
-FourMomentum& FourMomentum::operator=(const FourMomentum& other)
-{
-  // Check for self-assignment
-  if (this == &other) return *this;
-  // Copy four-momentum components
-  particle_px = other.particle_px;
-  particle_py = other.particle_py;
-  particle_pz = other.particle_pz;
-  particle_energy = other.particle_energy;
-  std::cout<<"FourMomentum copy assignment operator called."<<std::endl;
-  return *this;
-}
-
-FourMomentum& FourMomentum::operator=(FourMomentum&& other) noexcept
-{
-  // Check for self-assignment
-  if (this == &other) return *this;
-  // Move four-momentum components
-  particle_px = other.particle_px;
-  particle_py = other.particle_py;
-  particle_pz = other.particle_pz;
-  particle_energy = other.particle_energy;
-  std::cout<<"FourMomentum move assignment operator called."<<std::endl;
-  // Reset the moved-from object
-  other.particle_px = 0.0;
-  other.particle_py = 0.0;
-  other.particle_pz = 0.0;
-  other.particle_energy = 0.0;
-  return *this;
-}
-
-// [SETTERS AND VALIDATION]
-
-// Helper method to validate four-momentum components
-bool FourMomentum::validate_components(double px, double py, double pz, double energy)
-{
-   // Check for values exceeding maximum double
-  const double max_double = std::numeric_limits<double>::max();
-  if(std::fabs(px) >= max_double || std::fabs(py) >= max_double || 
-    std::fabs(pz) >= max_double || std::fabs(energy) >= max_double) {return false;}
-  // Energy must be non-negative
-  if(energy < 0.0) {return false;}
-  
-  // Check mass-shell constraint: E^2 >= p^2 (in natural units where c=1)
-  double p_squared = (px * px) + (py * py) + (pz * pz);
-  double mass_squared = (energy * energy) - p_squared;
-  
-  // Allow for small numerical errors
-  const double epsilon = 1e-10;
-  return mass_squared >= -epsilon;
-}
-
-// Method to set all components at once with validation
-void FourMomentum::set_momentum_components(double px, double py, double pz, double energy)
-{
-  // Only having one set function to set all components because having individual setters
-  // could violate the mass-shell condition
-  if(validate_components(px, py, pz, energy))
-  {
-    particle_px = px;
-    particle_py = py;
-    particle_pz = pz;
-    particle_energy = energy;
-  }
-  else
-  {
-    throw std::runtime_error(
-      "Invalid four-momentum components! Energy must be non-negative and E^2 >= p^2 must be satisfied.");
-  }
-}
-
 // [PHYSICS METHODS]
 
 double FourMomentum::calculate_invariant_mass() const
@@ -156,45 +53,28 @@ double FourMomentum::calculate_momentum_magnitude() const
 
 double FourMomentum::calculate_pseudorapidity() const
 {
-  double momentum_magnitude = calculate_momentum_magnitude();
-  
-  // Handle case where momentum is zero
-  if(momentum_magnitude < 1e-10) {return 0.0;}
-    
-  double cos_theta = particle_pz / momentum_magnitude;
-  
-  // Handle edge cases
-  if(cos_theta >= 1.0) {return std::numeric_limits<double>::infinity();}
-  if(cos_theta <= -1.0) {return -std::numeric_limits<double>::infinity();}
-    
-  // Compute pseudorapidity
-  double theta = std::acos(cos_theta);
-  if(theta < 1e-10) {return std::numeric_limits<double>::infinity();}
-    
-  return -std::log(std::tan(theta / 2.0));
+  // Closed form η = sign(pz) ln((|p| + |pz|) / pT), shared with the batch kinematics kernel
+  return pseudorapidity(particle_px, particle_py, particle_pz);
+}
+
+double FourMomentum::calculate_azimuthal_angle() const
+{
+  return std::atan2(particle_py, particle_px);
 }
 
 // Static method to calculate invariant mass of a system of particles
 double FourMomentum::calculate_system_invariant_mass(const std::vector<FourMomentum>& momenta)
 {
-  // Throw an error if the input vector is empty (no particles to process)
-  if(momenta.empty()) {throw std::invalid_argument(
+  return calculate_system_invariant_mass(momenta.data(), momenta.size());
+}
+
+double FourMomentum::calculate_system_invariant_mass(const FourMomentum* momenta, std::size_t count)
+{
+  // Throw an error if the input is empty (no particles to process)
+  if(count == 0) {throw std::invalid_argument(
     "Four Momentum vector is empty. Cannot calculate system invariant mass. Exiting program.");}
-  // Variables to accumulate the total momentum components and energy
-  double total_px = 0.0;
-  double total_py = 0.0;
-  double total_pz = 0.0;
-  double total_energy = 0.0;
-  // Loop through each particle's four-momentum and sum the components
-  for(const auto& momentum : momenta)
-  {
-    total_px += momentum.get_px();
-    total_py += momentum.get_py();
-    total_pz += momentum.get_pz();
-    total_energy += momentum.get_energy();
-  }
-  // Create temporary four-momentum for the total system
-  FourMomentum total_momentum(total_px, total_py, total_pz, total_energy);
+  // Sum the four-momenta of all particles to get the total momentum of the system
+  const FourMomentum total_momentum = std::accumulate(momenta, momenta + count, FourMomentum());
   return total_momentum.calculate_invariant_mass();
 }
 
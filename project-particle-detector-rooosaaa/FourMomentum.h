@@ -7,7 +7,8 @@
 // vector (px, py, pz, E) used in particle physics.
 //
 // This implementation includes:
-// - Memory management (constructors, destructors, and assignment operators)
+// - A trivially copyable, constexpr-capable value type (compiler-generated copies and moves)
+// - Arithmetic operators (+, - and scalar *) for sums such as a system's total momentum
 // - Component setters with validation for physical constraints
 // - Enforcement of relativistic constraints (E² ≥ p², non-negative energy)
 // - Functions to perform several calculations using the four momentum, including
@@ -21,8 +22,11 @@
 #define FOUR_MOMENTUM_H
 
 #include<cmath>
+#include<cstddef>
 #include<iostream>
+#include<limits>
 #include<stdexcept>
+#include<type_traits>
 #include<vector>
 
 namespace ParticleProperties
@@ -36,34 +40,94 @@ namespace ParticleProperties
     double particle_pz; // z-component of momentum in GeV
     double particle_energy; // energy (E) in GeV
 
+    // Tag selecting the unchecked constructor used by the arithmetic operators
+    struct Unchecked {};
+    // Unchecked constructor: results of arithmetic are general four-vectors (e.g. the
+    // difference of two momenta need not be on the mass shell), so they are not validated
+    constexpr FourMomentum(Unchecked, double px, double py, double pz, double energy) :
+      particle_px{px}, particle_py{py}, particle_pz{pz}, particle_energy{energy} {}
+
   public:
     // [RULE OF 5]
-    // Default constructor
-    FourMomentum();
-    // Parameterized constructor
-    FourMomentum(double px, double py, double pz, double energy);
-    // Copy constructor
-    FourMomentum(const FourMomentum& other);
-    // Move constructor
-    FourMomentum(FourMomentum&& other) noexcept;
-    // Destructor
-    ~FourMomentum();
-    // Copy assignment operator
-    FourMomentum& operator=(const FourMomentum& other);
-    // Move assignment operator
-    FourMomentum& operator=(FourMomentum&& other) noexcept;
+    // Default constructor: four-momentum initialised to zero
+    constexpr FourMomentum() : particle_px{0.0}, particle_py{0.0}, particle_pz{0.0}, particle_energy{0.0} {}
+    // Parameterized constructor (validated, see validate_components)
+    constexpr FourMomentum(double px, double py, double pz, double energy) :
+      particle_px{0.0}, particle_py{0.0}, particle_pz{0.0}, particle_energy{0.0}
+    {
+      set_momentum_components(px, py, pz, energy);
+    }
+    // The copy/move operations and the destructor are the compiler-generated ones, so a
+    // four-momentum is trivially copyable: it can be copied with memcpy and kept in
+    // vectorised containers, and copying it is just copying four doubles
+    FourMomentum(const FourMomentum& other) = default;
+    FourMomentum(FourMomentum&& other) noexcept = default;
+    ~FourMomentum() = default;
+    FourMomentum& operator=(const FourMomentum& other) = default;
+    FourMomentum& operator=(FourMomentum&& other) noexcept = default;
 
     // [SETTERS & VALIDATION]
     // Method to set all components at once with validation - avoids mass-shell violation
-    void set_momentum_components(double px, double py, double pz, double energy);
-    // Helper method to validate four momentum components
-    static bool validate_components(double px, double py, double pz, double energy);
+    constexpr void set_momentum_components(double px, double py, double pz, double energy)
+    {
+      // Only having one set function to set all components because having individual setters
+      // could violate the mass-shell condition
+      if(!validate_components(px, py, pz, energy))
+      {
+        throw std::runtime_error(
+          "Invalid four-momentum components! Energy must be non-negative and E^2 >= p^2 must be satisfied.");
+      }
+      particle_px = px;
+      particle_py = py;
+      particle_pz = pz;
+      particle_energy = energy;
+    }
+    // Helper method to validate four momentum components:
+    // - all components finite, energy non-negative and E^2 >= p^2 (up to rounding)
+    static constexpr bool validate_components(double px, double py, double pz, double energy)
+    {
+      // Check for values reaching the maximum double (written without std::fabs, which is
+      // not constexpr); NaN components also fail this check
+      const double max_double = std::numeric_limits<double>::max();
+      if(!(px < max_double && -px < max_double && py < max_double && -py < max_double &&
+        pz < max_double && -pz < max_double && energy < max_double)) {return false;}
+      // Energy must be non-negative
+      if(energy < 0.0) {return false;}
+      // Check mass-shell constraint: E^2 >= p^2 (in natural units where c=1)
+      const double p_squared = (px * px) + (py * py) + (pz * pz);
+      const double mass_squared = (energy * energy) - p_squared;
+      // Allow for small numerical errors
+      const double epsilon = 1e-10;
+      return mass_squared >= -epsilon;
+    }
 
     // [GETTERS]
-    double get_px() const {return particle_px;}
-    double get_py() const {return particle_py;}
-    double get_pz() const {return particle_pz;}
-    double get_energy() const {return particle_energy;}
+    constexpr double get_px() const {return particle_px;}
+    constexpr double get_py() const {return particle_py;}
+    constexpr double get_pz() const {return particle_pz;}
+    constexpr double get_energy() const {return particle_energy;}
+
+    // [ARITHMETIC OPERATORS]
+    // Component-wise four-vector arithmetic. The sum of physical momenta is always physical;
+    // differences and scaled momenta are returned as they are, without validation.
+    constexpr FourMomentum operator+(const FourMomentum& other) const
+    {
+      return FourMomentum(Unchecked{}, particle_px + other.particle_px, particle_py + other.particle_py,
+        particle_pz + other.particle_pz, particle_energy + other.particle_energy);
+    }
+    constexpr FourMomentum operator-(const FourMomentum& other) const
+    {
+      return FourMomentum(Unchecked{}, particle_px - other.particle_px, particle_py - other.particle_py,
+        particle_pz - other.particle_pz, particle_energy - other.particle_energy);
+    }
+    constexpr FourMomentum operator*(double scale) const
+    {
+      return FourMomentum(Unchecked{}, particle_px * scale, particle_py * scale, particle_pz * scale,
+        particle_energy * scale);
+    }
+    friend constexpr FourMomentum operator*(double scale, const FourMomentum& momentum) {return momentum * scale;}
+    constexpr FourMomentum& operator+=(const FourMomentum& other) {return *this = *this + other;}
+    constexpr FourMomentum& operator-=(const FourMomentum& other) {return *this = *this - other;}
       
     // [PHYSICS METHODS]
     // Calculate the invariant mass (m^2 = E^2 - p^2)
@@ -74,12 +138,18 @@ namespace ParticleProperties
     double calculate_momentum_magnitude() const;
     // Calculate pseudorapidity (η = -ln(tan(θ/2)), where θ is the polar angle)
     double calculate_pseudorapidity() const;
+    // Calculate the azimuthal angle (φ = atan2(py, px)) in radians
+    double calculate_azimuthal_angle() const;
     // Static method to calculate invariant mass of a system of particles
     static double calculate_system_invariant_mass(const std::vector<FourMomentum>& momenta);
+    // Same as above for `count` momenta stored contiguously (e.g. in an arena-backed vector)
+    static double calculate_system_invariant_mass(const FourMomentum* momenta, std::size_t count);
 
     // [PRINT METHOD]
     void print() const;
   };
+
+  static_assert(std::is_trivially_copyable_v<FourMomentum>, "FourMomentum must stay trivially copyable");
 } // namespace ParticleProperties
 
-#endif // FOUR_MOMENTUM_H
\ No newline at end of file
+#endif // FOUR_MOMENTUM_H
@@ -0,0 +1,152 @@
+// Generator.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `Generator` class template, the return type of a C++20
+// coroutine that produces a sequence of values lazily with `co_yield`. Nothing is computed
+// until the consumer asks for the first value, and the coroutine is suspended after each
+// value until the consumer asks for the next one, so a producer of any number of events or
+// particles only ever holds the one being consumed:
+//
+//   Generator<ParticlePtr> simulate_higgs_decay(ParticlePools& pools)
+//   {
+//     co_yield pools.make_particle<Photon>(1, FourMomentum(30.0, 25.0, 0.0, 60.0));
+//     ...
+//   }
+//
+//   for(ParticlePtr& particle : simulate_higgs_decay(pools)) {...}
+//
+// A generator is a single-pass input range: begin() starts (or continues) the coroutine and
+// can be called once. The iterator gives a non-const reference to the yielded value, which
+// the consumer may move from (e.g. to keep a yielded ParticlePtr). An exception thrown by the
+// coroutine is rethrown from begin() or operator++ of the consumer.
+//
+// The project must be compiled as C++20 (-std=gnu++20) for coroutine support.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef GENERATOR_H
+#define GENERATOR_H
+
+#include<coroutine>
+#include<cstddef>
+#include<exception>
+#include<iterator>
+#include<memory>
+#include<utility>
+
+namespace ParticleSystem
+{
+  template<typename T>
+  class Generator
+  {
+  public:
+    struct promise_type
+    {
+      // The yielded value stays alive in the suspended coroutine, so only its address is kept
+      T* current_value = nullptr;
+      std::exception_ptr error;
+
+      Generator get_return_object() {return Generator{std::coroutine_handle<promise_type>::from_promise(*this)};}
+      // Lazy: the body only starts running when the consumer asks for the first value
+      std::suspend_always initial_suspend() noexcept {return {};}
+      std::suspend_always final_suspend() noexcept {return {};}
+      std::suspend_always yield_value(T& value) noexcept
+      {
+        current_value = std::addressof(value);
+        return {};
+      }
+      // A temporary lives until the end of the co_yield expression, i.e. while suspended
+      std::suspend_always yield_value(T&& value) noexcept
+      {
+        current_value = std::addressof(value);
+        return {};
+      }
+      void return_void() noexcept {}
+      void unhandled_exception() {error = std::current_exception();}
+      // co_await is not supported inside a generator
+      template<typename U> std::suspend_never await_transform(U&& value) = delete;
+    };
+
+    struct sentinel {};
+
+    class iterator
+    {
+    private:
+      std::coroutine_handle<promise_type> coroutine;
+
+    public:
+      using iterator_category = std::input_iterator_tag;
+      using difference_type = std::ptrdiff_t;
+      using value_type = T;
+      using reference = T&;
+      using pointer = T*;
+
+      iterator() = default;
+      explicit iterator(std::coroutine_handle<promise_type> handle) : coroutine{handle} {}
+
+      reference operator*() const {return *coroutine.promise().current_value;}
+      pointer operator->() const {return coroutine.promise().current_value;}
+      // Resume the coroutine up to its next co_yield (or its end)
+      iterator& operator++()
+      {
+        resume(coroutine);
+        return *this;
+      }
+      void operator++(int) {++*this;}
+      bool operator==(sentinel) const {return !coroutine || coroutine.done();}
+      bool operator!=(sentinel end) const {return !(*this == end);}
+    };
+
+  private:
+    std::coroutine_handle<promise_type> coroutine;
+
+    explicit Generator(std::coroutine_handle<promise_type> handle) : coroutine{handle} {}
+
+    // Run the coroutine to its next suspension point and rethrow anything it threw
+    static void resume(std::coroutine_handle<promise_type> handle)
+    {
+      handle.resume();
+      if(handle.promise().error) {std::rethrow_exception(std::exchange(handle.promise().error, nullptr));}
+    }
+
+  public:
+    // [RULE OF 5]
+    // Only move operations, as a generator owns its coroutine frame
+    // Copy constructor
+    Generator(const Generator& other) = delete;
+    // Move constructor
+    Generator(Generator&& other) noexcept : coroutine{std::exchange(other.coroutine, nullptr)} {}
+    // Copy assignment operator
+    Generator& operator=(const Generator& other) = delete;
+    // Move assignment operator
+    Generator& operator=(Generator&& other) noexcept
+    {
+      if(this != &other)
+      {
+        if(coroutine) {coroutine.destroy();}
+        coroutine = std::exchange(other.coroutine, nullptr);
+      }
+      return *this;
+    }
+    // Destructor, destroys the coroutine frame and with it anything the coroutine still holds
+    ~Generator()
+    {
+      if(coroutine) {coroutine.destroy();}
+    }
+
+    // [METHODS]
+    // Start the coroutine and return an iterator to its first value
+    iterator begin()
+    {
+      if(coroutine) {resume(coroutine);}
+      return iterator{coroutine};
+    }
+    sentinel end() const noexcept {return {};}
+  };
+} // namespace ParticleSystem
+
+#endif // GENERATOR_H
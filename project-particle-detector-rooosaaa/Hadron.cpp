@@ -10,8 +10,7 @@
 // The implementation includes:
 // - Rule of 5 methods for proper memory management
 // - Setter methods for the name and charge of the hadron with validation
-// - Methods for printing the hadron's properties and checking detection compatibility with various
-//   detector types
+// - Methods for printing the hadron's properties
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -20,6 +19,7 @@
 #include<iostream>
 
 #include "Hadron.h"
+#include "Logging.h"
 
 using namespace ParticleSystem;
 
@@ -34,12 +34,12 @@ Hadron::Hadron(int id, const FourMomentum& momentum, std::string name, double ch
 
 Hadron::~Hadron()
 {
-  std::cout<<"Hadron destructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Hadron destructor called.");
 }
 
 Hadron::Hadron(const Hadron& other) : Particle(other)
 {
-  std::cout<<"Hadron copy constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Hadron copy constructor called.");
   // Copy the hadron properties
   particle_name = other.particle_name;
   particle_four_momentum = other.particle_four_momentum;
@@ -49,7 +49,7 @@ Hadron::Hadron(const Hadron& other) : Particle(other)
 
 Hadron::Hadron(Hadron&& other) noexcept : Particle(std::move(other))
 {
-  std::cout<<"Hadron move constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Hadron move constructor called.");
   // Move the hadron properties
   particle_name = std::move(other.particle_name);
   // Call move assignment operator for FourMomentum
@@ -63,7 +63,7 @@ Hadron::Hadron(Hadron&& other) noexcept : Particle(std::move(other))
 
 Hadron& Hadron::operator=(const Hadron& other)
 {
-  std::cout<<"Hadron copy assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Hadron copy assignment operator called.");
   if(this != &other)
   {
     // Copy the hadron properties
@@ -77,7 +77,7 @@ Hadron& Hadron::operator=(const Hadron& other)
 
 Hadron& Hadron::operator=(Hadron&& other) noexcept
 {
-  std::cout<<"Hadron move assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Hadron move assignment operator called.");
   if(this != &other)
   {
     // Move the hadron properties
@@ -129,11 +129,3 @@ void Hadron::print() const
   std::cout<<"ID: "<<particle_id<<std::endl;
   std::cout<<"Charge (e): "<<particle_charge<<std::endl;
 }
-
-// Detection method
-bool Hadron::can_be_detected_by(const std::string& detector_type) const
-{
-  // Check if the hadron can be detected by the given detector type
-  if(detector_type == "Hadronic Calorimeter" || detector_type == "Tracker") {return true;}
-  else {return false;}
-}
@@ -36,16 +36,15 @@ namespace ParticleSystem
     // Destructor
     ~Hadron();
 
+    // [GETTERS]
+    ParticleType get_type() const override {return ParticleType::Hadron;}
+
     // [SETTERS]
     void set_name(std::string name) override;
     void set_charge(double charge) override;
     
     // [PRINT METHOD]
     void print() const override;
-    
-    // [DETECTION METHOD]
-    // Method to check if particle can be detected by a detector type
-    bool can_be_detected_by(const std::string& detectorType) const override;
   };
 } // namespace ParticleSystem
 
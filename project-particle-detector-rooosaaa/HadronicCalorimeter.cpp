@@ -22,6 +22,7 @@
 #include<climits>  // For INT_MAX
 
 #include "HadronicCalorimeter.h"
+#include "Logging.h"
 
 using namespace DetectorSubsystems;
 
@@ -29,7 +30,7 @@ using namespace DetectorSubsystems;
 
 HadronicCalorimeter::HadronicCalorimeter() : Calorimeter("Hadronic Calorimeter", 0, 1, 3)
 {
-  std::cout<<"Calling HadronicCalorimeter class default constructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling HadronicCalorimeter class default constructor.");
   // Default materials for the calorimeter
   // Using a list so that we can easily add or remove materials
   std::list<std::string> materials = {"Steel", "PST"};
@@ -42,12 +43,12 @@ HadronicCalorimeter::HadronicCalorimeter(int resolution, double energy_loss, int
 {
   // Using a list so that we can easily add or remove materials
   set_hadronic_cal_materials(materials);
-  // The SubDetector base class constructor seeds the random generator and validates the resolution
+  // The SubDetector base class constructor seeds the random stream and validates the resolution
 }
 
 HadronicCalorimeter::~HadronicCalorimeter()
 {
-  std::cout<<"Calling HadronicCalorimeter class destructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling HadronicCalorimeter class destructor.");
 }
 
 // [SETTERS]
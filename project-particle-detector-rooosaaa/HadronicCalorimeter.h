@@ -39,6 +39,9 @@ namespace DetectorSubsystems
     // Any additional properties of the HadronicCalorimeter can be added here
   
   public:
+    // Compile-time type code of this sub-detector, used by StaticDetector
+    static constexpr SubDetectorType static_type_id = SubDetectorType::HadronicCalorimeter;
+
     // [RULE OF 5]
     // Default constructor - resolution is set to 0 and energy loss to 1 (perfect Tracker)
     HadronicCalorimeter();
@@ -0,0 +1,168 @@
+// Histogram.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the HistogramBinning, Histogram and ConcurrentHistogram classes.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<cmath>
+#include<iomanip>
+#include<iostream>
+#include<stdexcept>
+#include<utility>
+
+#include "Histogram.h"
+
+using namespace ParticleDetector;
+
+// [BINNING]
+
+HistogramBinning::HistogramBinning(std::size_t number_of_bins, double low, double high) : uniform{true}
+{
+  if(number_of_bins == 0) {throw std::invalid_argument("Error: A histogram needs at least one bin.");}
+  if(!std::isfinite(low) || !std::isfinite(high) || !(low < high)) {throw std::invalid_argument(
+    "Error: Histogram range must be finite with low < high.");}
+  edges.resize(number_of_bins + 1);
+  const double bin_width = (high - low) / static_cast<double>(number_of_bins);
+  for(std::size_t i = 0; i < number_of_bins; ++i) {edges[i] = low + static_cast<double>(i) * bin_width;}
+  edges.back() = high;
+  inverse_bin_width = static_cast<double>(number_of_bins) / (high - low);
+}
+
+HistogramBinning::HistogramBinning(std::vector<double> bin_edges) : edges{std::move(bin_edges)}, uniform{false},
+  inverse_bin_width{0.0}
+{
+  if(edges.size() < 2) {throw std::invalid_argument("Error: A histogram needs at least two bin edges.");}
+  for(std::size_t i = 0; i < edges.size(); ++i)
+  {
+    if(!std::isfinite(edges[i])) {throw std::invalid_argument("Error: Histogram bin edges must be finite.");}
+    if(i > 0 && !(edges[i - 1] < edges[i])) {throw std::invalid_argument(
+      "Error: Histogram bin edges must be strictly increasing.");}
+  }
+}
+
+// [HISTOGRAM]
+
+Histogram::Histogram(HistogramBinning histogram_binning) : binning{std::move(histogram_binning)},
+  sum_of_weights(binning.get_number_of_bins() + 2, 0.0), sum_of_weights_squared(binning.get_number_of_bins() + 2, 0.0),
+  entries{0}, sum_of_weighted_values{0.0}
+{}
+
+double Histogram::get_bin_error(std::size_t bin) const
+{
+  return std::sqrt(sum_of_weights_squared.at(bin));
+}
+
+double Histogram::get_integral() const
+{
+  double integral = 0.0;
+  for(std::size_t bin = 1; bin + 1 < sum_of_weights.size(); ++bin) {integral += sum_of_weights[bin];}
+  return integral;
+}
+
+double Histogram::get_mean() const
+{
+  const double integral = get_integral();
+  return integral != 0.0 ? sum_of_weighted_values / integral : 0.0;
+}
+
+void Histogram::fill(double value, double weight)
+{
+  const std::size_t bin = binning.find_bin(value);
+  sum_of_weights[bin] += weight;
+  sum_of_weights_squared[bin] += weight * weight;
+  ++entries;
+  if(bin != 0 && bin + 1 != sum_of_weights.size()) {sum_of_weighted_values += weight * value;}
+}
+
+void Histogram::add(const Histogram& other)
+{
+  if(binning != other.binning) {throw std::invalid_argument(
+    "Error: Cannot add histograms with different binning.");}
+  for(std::size_t bin = 0; bin < sum_of_weights.size(); ++bin)
+  {
+    sum_of_weights[bin] += other.sum_of_weights[bin];
+    sum_of_weights_squared[bin] += other.sum_of_weights_squared[bin];
+  }
+  entries += other.entries;
+  sum_of_weighted_values += other.sum_of_weighted_values;
+}
+
+void Histogram::reset()
+{
+  std::fill(sum_of_weights.begin(), sum_of_weights.end(), 0.0);
+  std::fill(sum_of_weights_squared.begin(), sum_of_weights_squared.end(), 0.0);
+  entries = 0;
+  sum_of_weighted_values = 0.0;
+}
+
+void Histogram::print(const std::string& title) const
+{
+  const auto& edges = binning.get_edges();
+  std::cout<<std::fixed<<std::setprecision(2);
+  std::cout<<"\n=== [Histogram: "<<title<<"] ==="<<std::endl;
+  std::cout<<"Entries: "<<entries<<", mean: "<<get_mean()<<", underflow: "<<get_underflow()
+    <<", overflow: "<<get_overflow()<<std::endl;
+  for(std::size_t bin = 1; bin + 1 < sum_of_weights.size(); ++bin)
+  {
+    if(sum_of_weights[bin] == 0.0) {continue;}
+    std::cout<<"  ["<<edges[bin - 1]<<", "<<edges[bin]<<"): "<<sum_of_weights[bin]<<std::endl;
+  }
+}
+
+// [CONCURRENT HISTOGRAM]
+
+namespace
+{
+  // Offsets within a shard, for a binning with `bins` bins including underflow and overflow:
+  // [0, bins) sums of weights, [bins, 2 bins) sums of squared weights,
+  // 2 bins: number of entries, 2 bins + 1: sum of weight * value
+  constexpr std::size_t shard_layout(std::size_t bins) {return 2 * bins + 2;}
+}
+
+ConcurrentHistogram::ConcurrentHistogram(HistogramBinning histogram_binning, std::size_t shards) :
+  binning{std::move(histogram_binning)}, number_of_shards{shards}
+{
+  if(number_of_shards == 0) {throw std::invalid_argument(
+    "Error: A concurrent histogram needs at least one shard.");}
+  constexpr std::size_t doubles_per_line = cache_line_size / sizeof(double);
+  const std::size_t lines_per_shard = (shard_layout(binning.get_number_of_bins() + 2) + doubles_per_line - 1)
+    / doubles_per_line;
+  shard_stride = lines_per_shard * doubles_per_line;
+  storage.resize(lines_per_shard * number_of_shards);
+  reset();
+}
+
+ConcurrentHistogram::Shard ConcurrentHistogram::get_shard(std::size_t shard)
+{
+  if(shard >= number_of_shards) {throw std::out_of_range("Error: Histogram shard index out of range.");}
+  return Shard(&binning, shard_data(shard));
+}
+
+Histogram ConcurrentHistogram::merge() const
+{
+  Histogram merged(binning);
+  const std::size_t bins = binning.get_number_of_bins() + 2;
+  for(std::size_t shard = 0; shard < number_of_shards; ++shard)
+  {
+    const double* data = shard_data(shard);
+    for(std::size_t bin = 0; bin < bins; ++bin)
+    {
+      merged.sum_of_weights[bin] += data[bin];
+      merged.sum_of_weights_squared[bin] += data[bins + bin];
+    }
+    merged.entries += static_cast<std::uint64_t>(data[2 * bins]);
+    merged.sum_of_weighted_values += data[2 * bins + 1];
+  }
+  return merged;
+}
+
+void ConcurrentHistogram::reset()
+{
+  for(auto& line : storage) {std::fill(std::begin(line.values), std::end(line.values), 0.0);}
+}
@@ -0,0 +1,195 @@
+// Histogram.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the histogramming classes of the analysis:
+// - `HistogramBinning`: fixed-width or variable-width bins over [low, high), plus an
+//   underflow bin (0) and an overflow bin (number of bins + 1)
+// - `Histogram`: a weighted histogram with per-bin sums of weights and squared weights,
+//   filled from a single thread and used as the merged result
+// - `ConcurrentHistogram`: a histogram filled from many threads at once without locks or
+//   atomics. Each thread fills its own shard, and every shard starts on its own cache line
+//   so that threads never write to the same line. `merge` adds the shards (in shard order,
+//   so the result does not depend on thread timing) into a Histogram at the end.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef HISTOGRAM_H
+#define HISTOGRAM_H
+
+#include<algorithm>
+#include<cstddef>
+#include<cstdint>
+#include<string>
+#include<vector>
+
+#include "SimdSupport.h"
+
+namespace ParticleDetector
+{
+  using DetectorSimd::cache_line_size;
+
+  class HistogramBinning
+  {
+  private:
+    std::vector<double> edges; // number of bins + 1 strictly increasing edges
+    bool uniform; // fixed-width bins, found by arithmetic instead of a binary search
+    double inverse_bin_width;
+
+  public:
+    // [CONSTRUCTORS]
+    // Fixed-width bins; throws unless number_of_bins > 0 and low < high
+    HistogramBinning(std::size_t number_of_bins, double low, double high);
+    // Variable-width bins from their edges; throws unless there are at least two strictly
+    // increasing, finite edges
+    explicit HistogramBinning(std::vector<double> bin_edges);
+
+    // [GETTERS]
+    std::size_t get_number_of_bins() const {return edges.size() - 1;}
+    const std::vector<double>& get_edges() const {return edges;}
+    double get_low() const {return edges.front();}
+    double get_high() const {return edges.back();}
+    bool is_uniform() const {return uniform;}
+
+    // [METHODS]
+    // Bin of a value: 0 for underflow, 1 to number of bins in range and number of bins + 1
+    // for overflow (including NaN). Bins include their low edge.
+    std::size_t find_bin(double value) const
+    {
+      if(!(value >= edges.front())) {return value < edges.front() ? 0 : edges.size();}
+      if(value >= edges.back()) {return edges.size();}
+      if(uniform)
+      {
+        std::size_t bin = std::min(static_cast<std::size_t>((value - edges.front()) * inverse_bin_width),
+          edges.size() - 2);
+        // Correct rounding of the division so bins always agree with the stored edges
+        if(value < edges[bin]) {--bin;}
+        else if(value >= edges[bin + 1]) {++bin;}
+        return bin + 1;
+      }
+      return static_cast<std::size_t>(std::upper_bound(edges.begin(), edges.end(), value) - edges.begin());
+    }
+
+    bool operator==(const HistogramBinning& other) const {return edges == other.edges;}
+    bool operator!=(const HistogramBinning& other) const {return !(*this == other);}
+  };
+
+  class ConcurrentHistogram;
+
+  class Histogram
+  {
+    // Merges its shards directly into the bin sums
+    friend class ConcurrentHistogram;
+
+  private:
+    HistogramBinning binning;
+    // Per-bin sums, including the underflow and overflow bins
+    std::vector<double> sum_of_weights;
+    std::vector<double> sum_of_weights_squared;
+    std::uint64_t entries;
+    // Sum of weight * value over the in-range fills, for the mean
+    double sum_of_weighted_values;
+
+  public:
+    // [CONSTRUCTORS]
+    explicit Histogram(HistogramBinning histogram_binning);
+
+    // [GETTERS]
+    const HistogramBinning& get_binning() const {return binning;}
+    std::uint64_t get_entries() const {return entries;}
+    // Bin contents and errors (square root of the sum of squared weights); throws for an invalid bin
+    double get_bin_content(std::size_t bin) const {return sum_of_weights.at(bin);}
+    double get_bin_error(std::size_t bin) const;
+    double get_underflow() const {return sum_of_weights.front();}
+    double get_overflow() const {return sum_of_weights.back();}
+    // Sum of the in-range bin contents
+    double get_integral() const;
+    // Weighted mean of the in-range fills (0 if there are none)
+    double get_mean() const;
+
+    // [METHODS]
+    void fill(double value, double weight = 1.0);
+    // Add the contents of a histogram with identical binning; throws otherwise
+    void add(const Histogram& other);
+    void reset();
+    // Print the statistics and the contents of every non-empty bin
+    void print(const std::string& title) const;
+  };
+
+  class ConcurrentHistogram
+  {
+  private:
+    struct alignas(cache_line_size) CacheLine
+    {
+      double values[cache_line_size / sizeof(double)];
+    };
+
+    HistogramBinning binning;
+    std::size_t number_of_shards;
+    // Doubles per shard, rounded up to whole cache lines. Each shard holds the sums of weights
+    // and squared weights of every bin followed by the number of entries and the sum of
+    // weight * value (see shard_layout in Histogram.cpp).
+    std::size_t shard_stride;
+    std::vector<CacheLine> storage;
+
+    double* shard_data(std::size_t shard) {return storage.data()->values + shard * shard_stride;}
+    const double* shard_data(std::size_t shard) const {return storage.data()->values + shard * shard_stride;}
+
+  public:
+    // Handle through which one thread fills its shard. Only one thread may fill a given
+    // shard at a time; different shards can be filled concurrently.
+    class Shard
+    {
+      friend class ConcurrentHistogram;
+
+    private:
+      const HistogramBinning* binning;
+      double* data;
+      Shard(const HistogramBinning* histogram_binning, double* shard_data) :
+        binning{histogram_binning}, data{shard_data} {}
+
+    public:
+      void fill(double value, double weight = 1.0)
+      {
+        const std::size_t bins = binning->get_number_of_bins() + 2;
+        const std::size_t bin = binning->find_bin(value);
+        data[bin] += weight;
+        data[bins + bin] += weight * weight;
+        data[2 * bins] += 1.0;
+        if(bin != 0 && bin != bins - 1) {data[2 * bins + 1] += weight * value;}
+      }
+    };
+
+    // [RULE OF 5]
+    // Parameterised constructor; throws if number_of_shards is 0
+    ConcurrentHistogram(HistogramBinning histogram_binning, std::size_t shards);
+    // Not allowing copy or move operations as the shard handles point into the histogram
+    // Copy constructor
+    ConcurrentHistogram(const ConcurrentHistogram& other) = delete;
+    // Move constructor
+    ConcurrentHistogram(ConcurrentHistogram&& other) = delete;
+    // Copy assignment operator
+    ConcurrentHistogram& operator=(const ConcurrentHistogram& other) = delete;
+    // Move assignment operator
+    ConcurrentHistogram& operator=(ConcurrentHistogram&& other) = delete;
+    // Destructor
+    ~ConcurrentHistogram() = default;
+
+    // [GETTERS]
+    const HistogramBinning& get_binning() const {return binning;}
+    std::size_t get_number_of_shards() const {return number_of_shards;}
+    // Handle of one shard; throws for an invalid shard index
+    Shard get_shard(std::size_t shard);
+
+    // [METHODS]
+    // Sum of all shards. Must not run while shards are being filled.
+    Histogram merge() const;
+    // Clear every shard. Must not run while shards are being filled.
+    void reset();
+  };
+} // namespace ParticleDetector
+
+#endif // HISTOGRAM_H
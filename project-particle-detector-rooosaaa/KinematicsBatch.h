@@ -0,0 +1,66 @@
+// KinematicsBatch.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `KinematicsBatch` structure, which stores the kinematic
+// quantities of every particle of a batch as one column per quantity (pT, |p|, mass, η
+// and φ), and `compute_kinematics`, which fills it from a ParticleBatchView in a single
+// pass of the batch kinematics kernel (see KinematicsKernel.h).
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef KINEMATICS_BATCH_H
+#define KINEMATICS_BATCH_H
+
+#include<cstddef>
+#include<vector>
+
+#include "KinematicsKernel.h"
+#include "ParticleBatchView.h"
+
+namespace ParticleSystem
+{
+  struct KinematicsBatch
+  {
+    // [COLUMNS]
+    // One entry per particle; momenta and masses in GeV, angles in radians
+    std::vector<double> transverse_momentum;
+    std::vector<double> momentum_magnitude;
+    std::vector<double> invariant_mass;
+    std::vector<double> pseudorapidity;
+    std::vector<double> azimuthal_angle;
+
+    // [METHODS]
+    // Resize every column to hold the given number of particles
+    void resize(std::size_t particles)
+    {
+      transverse_momentum.resize(particles);
+      momentum_magnitude.resize(particles);
+      invariant_mass.resize(particles);
+      pseudorapidity.resize(particles);
+      azimuthal_angle.resize(particles);
+    }
+
+    // [GETTERS]
+    std::size_t size() const {return transverse_momentum.size();}
+  };
+
+  // Compute every kinematic column of a batch
+  inline void compute_kinematics(const ParticleBatchView& batch, KinematicsBatch& kinematics)
+  {
+    const std::size_t particles = batch.number_of_particles();
+    kinematics.resize(particles);
+    ParticleProperties::KinematicsOutput output;
+    output.transverse_momentum = kinematics.transverse_momentum.data();
+    output.momentum_magnitude = kinematics.momentum_magnitude.data();
+    output.invariant_mass = kinematics.invariant_mass.data();
+    output.pseudorapidity = kinematics.pseudorapidity.data();
+    output.azimuthal_angle = kinematics.azimuthal_angle.data();
+    ParticleProperties::compute_kinematics(batch.px, batch.py, batch.pz, batch.energy, particles, output);
+  }
+} // namespace ParticleSystem
+
+#endif // KINEMATICS_BATCH_H
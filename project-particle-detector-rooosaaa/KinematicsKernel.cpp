@@ -0,0 +1,386 @@
+// KinematicsKernel.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the batch kinematics kernel. As in SmearingKernel.cpp, the vector
+// code paths are compiled with per-function target attributes and without floating-point
+// contraction, so they round exactly like the scalar path (built with -ffp-contract=off).
+//
+// The vector logarithm only has to handle arguments x >= 1 (the pseudorapidity ratio): it
+// splits x = 2^e * m with m in [√½, √2) using the bits of x, and evaluates
+// ln(m) = 2 atanh(s) = 2 (s + s^3/3 + s^5/5 + ...) with s = (m - 1) / (m + 1), |s| < 0.172.
+// Infinite and NaN ratios are passed through unchanged, as their logarithm is the ratio itself.
+//
+// The vector arctangent reduces |py / px| to |t| <= 0.66 and uses the rational approximation
+// of the Cephes library; components that are zero, infinite or NaN are recomputed with
+// std::atan2 so that its special cases (e.g. the signed zeros) are kept.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<cmath>
+#include<limits>
+
+#include "KinematicsKernel.h"
+#include "SimdSupport.h"
+
+#if PARTICLE_DETECTOR_X86_SIMD
+#include<immintrin.h>
+#endif
+
+namespace ParticleProperties
+{
+  namespace
+  {
+    // Momenta below this magnitude have a pseudorapidity of zero (as in FourMomentum)
+    constexpr double minimum_momentum = 1e-10;
+    // Massless particles whose m^2 is within rounding of zero have a mass of zero
+    constexpr double mass_squared_tolerance = 1e-10;
+
+    // Mass from m^2, with the same handling of rounding as FourMomentum::calculate_invariant_mass
+    inline double mass_from_squared(double mass_squared)
+    {
+      if(mass_squared < 0 && mass_squared > -mass_squared_tolerance) {return 0.0;}
+      return std::sqrt(mass_squared);
+    }
+
+    // Pseudorapidity from pT, |p| and pz; log(∞) = ∞ covers particles along the beam axis
+    inline double pseudorapidity_from(double transverse_momentum, double momentum_magnitude, double pz)
+    {
+      if(momentum_magnitude < minimum_momentum) {return 0.0;}
+      return std::copysign(std::log((momentum_magnitude + std::abs(pz)) / transverse_momentum), pz);
+    }
+
+    // Reference implementation, also used for the tails of the vector loops
+    void kinematics_scalar(const double* px, const double* py, const double* pz, const double* energy,
+      std::size_t first, std::size_t count, const KinematicsOutput& output)
+    {
+      for(std::size_t i = first; i < count; ++i)
+      {
+        const double transverse_squared = px[i] * px[i] + py[i] * py[i];
+        const double momentum_squared = transverse_squared + pz[i] * pz[i];
+        const double transverse_momentum = std::sqrt(transverse_squared);
+        const double momentum_magnitude = std::sqrt(momentum_squared);
+        if(output.transverse_momentum) {output.transverse_momentum[i] = transverse_momentum;}
+        if(output.momentum_magnitude) {output.momentum_magnitude[i] = momentum_magnitude;}
+        if(output.invariant_mass)
+        {
+          output.invariant_mass[i] = mass_from_squared(energy[i] * energy[i] - momentum_squared);
+        }
+        if(output.pseudorapidity)
+        {
+          output.pseudorapidity[i] = pseudorapidity_from(transverse_momentum, momentum_magnitude, pz[i]);
+        }
+        if(output.azimuthal_angle) {output.azimuthal_angle[i] = std::atan2(py[i], px[i]);}
+      }
+    }
+
+#if PARTICLE_DETECTOR_X86_SIMD
+    // Coefficients 2 / (2k + 1) of the atanh series, highest power first
+    constexpr double log_series[] = {2.0 / 23, 2.0 / 21, 2.0 / 19, 2.0 / 17, 2.0 / 15, 2.0 / 13,
+      2.0 / 11, 2.0 / 9, 2.0 / 7, 2.0 / 5, 2.0 / 3, 2.0};
+    // ln 2 split into a part with trailing zero bits (exact when multiplied by the exponent)
+    // and the remainder
+    constexpr double ln2_high = 6.93147180369123816490e-01;
+    constexpr double ln2_low = 1.90821492927058770002e-10;
+    constexpr long long mantissa_bits = 0x000FFFFFFFFFFFFFLL;
+    constexpr long long exponent_of_one = 0x3FF0000000000000LL;
+    // Adding an integer 0 <= n < 2^52 to the bits of 2^52 gives the double 2^52 + n
+    constexpr long long two_to_52_bits = 0x4330000000000000LL;
+    constexpr double two_to_52 = 4503599627370496.0;
+    constexpr double square_root_of_two = 1.41421356237309504880;
+    // Rational approximation of atan on [-0.66, 0.66] (Cephes): atan(x) = x + x z P(z) / Q(z)
+    // with z = x^2, highest power first (Q has a leading coefficient of one)
+    constexpr double atan_numerator[] = {-8.750608600031904122785e-01, -1.615753718733365076637e+01,
+      -7.500855792314704667340e+01, -1.228866684490136173410e+02, -6.485021904942025371773e+01};
+    constexpr double atan_denominator[] = {2.485846490142306297962e+01, 1.650270098316988542046e+02,
+      4.328810604912902668951e+02, 4.853903996359136964868e+02, 1.945506571482613964425e+02};
+    constexpr double tan_three_pi_over_8 = 2.41421356237309504880;
+    constexpr double pi = 3.14159265358979311600;
+    constexpr double pi_over_2 = 1.57079632679489655800;
+    constexpr double pi_over_4 = 7.85398163397448278999e-01;
+    // Parts of π and π/2 lost in rounding them to doubles
+    constexpr double pi_low = 1.22464679914735317723e-16;
+    constexpr double pi_over_2_low = 6.12323399573676588613e-17;
+
+    // Natural logarithm of four finite values x >= 1
+    __attribute__((target("avx2"), optimize("fp-contract=off")))
+    inline __m256d log_avx2(__m256d x)
+    {
+      const __m256i bits = _mm256_castpd_si256(x);
+      __m256i exponent = _mm256_sub_epi64(_mm256_srli_epi64(bits, 52), _mm256_set1_epi64x(1023));
+      __m256d mantissa = _mm256_castsi256_pd(_mm256_or_si256(
+        _mm256_and_si256(bits, _mm256_set1_epi64x(mantissa_bits)), _mm256_set1_epi64x(exponent_of_one)));
+      // Move mantissas above √2 to [√½, 1) and raise their exponent by one (the mask is -1)
+      const __m256d large = _mm256_cmp_pd(mantissa, _mm256_set1_pd(square_root_of_two), _CMP_GT_OQ);
+      mantissa = _mm256_blendv_pd(mantissa, _mm256_mul_pd(mantissa, _mm256_set1_pd(0.5)), large);
+      exponent = _mm256_sub_epi64(exponent, _mm256_castpd_si256(large));
+      const __m256d scale = _mm256_sub_pd(_mm256_castsi256_pd(
+        _mm256_add_epi64(exponent, _mm256_set1_epi64x(two_to_52_bits))), _mm256_set1_pd(two_to_52));
+      const __m256d one = _mm256_set1_pd(1.0);
+      const __m256d s = _mm256_div_pd(_mm256_sub_pd(mantissa, one), _mm256_add_pd(mantissa, one));
+      const __m256d s_squared = _mm256_mul_pd(s, s);
+      __m256d series = _mm256_set1_pd(log_series[0]);
+      for(std::size_t k = 1; k < sizeof(log_series) / sizeof(log_series[0]); ++k)
+      {
+        series = _mm256_add_pd(_mm256_mul_pd(series, s_squared), _mm256_set1_pd(log_series[k]));
+      }
+      const __m256d log_mantissa = _mm256_mul_pd(s, series);
+      return _mm256_add_pd(_mm256_mul_pd(scale, _mm256_set1_pd(ln2_high)),
+        _mm256_add_pd(_mm256_mul_pd(scale, _mm256_set1_pd(ln2_low)), log_mantissa));
+    }
+
+    // Four-quadrant arctangent atan2(y, x) for finite, non-zero x and y: atan of |y| / |x|
+    // with the argument reduced to |t| <= 0.66 (atan t = π/2 + atan(-1/t) = π/4 + atan((t-1)/(t+1))),
+    // then moved to the quadrant of (x, y)
+    __attribute__((target("avx2"), optimize("fp-contract=off")))
+    inline __m256d atan2_avx2(__m256d y, __m256d x)
+    {
+      const __m256d sign_bit = _mm256_set1_pd(-0.0);
+      const __m256d one = _mm256_set1_pd(1.0);
+      const __m256d zero = _mm256_setzero_pd();
+      const __m256d ratio = _mm256_div_pd(_mm256_andnot_pd(sign_bit, y), _mm256_andnot_pd(sign_bit, x));
+      const __m256d large = _mm256_cmp_pd(ratio, _mm256_set1_pd(tan_three_pi_over_8), _CMP_GT_OQ);
+      const __m256d medium = _mm256_andnot_pd(large, _mm256_cmp_pd(ratio, _mm256_set1_pd(0.66), _CMP_GT_OQ));
+      // Reduced argument: -1/t (large), (t-1)/(t+1) (medium) or t, with a single division
+      const __m256d numerator = _mm256_blendv_pd(_mm256_blendv_pd(ratio, _mm256_sub_pd(ratio, one), medium),
+        _mm256_set1_pd(-1.0), large);
+      const __m256d denominator = _mm256_blendv_pd(_mm256_blendv_pd(one, _mm256_add_pd(ratio, one), medium),
+        ratio, large);
+      const __m256d reduced = _mm256_div_pd(numerator, denominator);
+      const __m256d base = _mm256_blendv_pd(_mm256_blendv_pd(zero, _mm256_set1_pd(pi_over_4), medium),
+        _mm256_set1_pd(pi_over_2), large);
+      const __m256d base_low = _mm256_blendv_pd(_mm256_blendv_pd(zero, _mm256_set1_pd(0.5 * pi_over_2_low), medium),
+        _mm256_set1_pd(pi_over_2_low), large);
+      const __m256d z = _mm256_mul_pd(reduced, reduced);
+      __m256d p = _mm256_set1_pd(atan_numerator[0]);
+      __m256d q = _mm256_add_pd(z, _mm256_set1_pd(atan_denominator[0]));
+      for(std::size_t k = 1; k < sizeof(atan_numerator) / sizeof(atan_numerator[0]); ++k)
+      {
+        p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(atan_numerator[k]));
+        q = _mm256_add_pd(_mm256_mul_pd(q, z), _mm256_set1_pd(atan_denominator[k]));
+      }
+      const __m256d correction = _mm256_add_pd(_mm256_mul_pd(reduced, _mm256_div_pd(_mm256_mul_pd(z, p), q)), reduced);
+      __m256d angle = _mm256_add_pd(base, _mm256_add_pd(correction, base_low));
+      // Second and third quadrants: π - angle
+      const __m256d negative_x = _mm256_cmp_pd(x, zero, _CMP_LT_OQ);
+      angle = _mm256_blendv_pd(angle, _mm256_add_pd(_mm256_sub_pd(_mm256_set1_pd(pi), angle), _mm256_set1_pd(pi_low)),
+        negative_x);
+      // The angle has the sign of y
+      return _mm256_or_pd(angle, _mm256_and_pd(sign_bit, y));
+    }
+
+    // Four particles per iteration
+    __attribute__((target("avx2"), optimize("fp-contract=off")))
+    void kinematics_avx2(const double* px, const double* py, const double* pz, const double* energy,
+      std::size_t count, const KinematicsOutput& output)
+    {
+      const __m256d sign_bit = _mm256_set1_pd(-0.0);
+      const __m256d infinity = _mm256_set1_pd(std::numeric_limits<double>::infinity());
+      const __m256d tolerance = _mm256_set1_pd(-mass_squared_tolerance);
+      const __m256d zero = _mm256_setzero_pd();
+      std::size_t i = 0;
+      for(; i + 4 <= count; i += 4)
+      {
+        const __m256d x = _mm256_loadu_pd(px + i);
+        const __m256d y = _mm256_loadu_pd(py + i);
+        const __m256d z = _mm256_loadu_pd(pz + i);
+        const __m256d transverse_squared = _mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y));
+        const __m256d momentum_squared = _mm256_add_pd(transverse_squared, _mm256_mul_pd(z, z));
+        const __m256d transverse_momentum = _mm256_sqrt_pd(transverse_squared);
+        const __m256d momentum_magnitude = _mm256_sqrt_pd(momentum_squared);
+        if(output.transverse_momentum) {_mm256_storeu_pd(output.transverse_momentum + i, transverse_momentum);}
+        if(output.momentum_magnitude) {_mm256_storeu_pd(output.momentum_magnitude + i, momentum_magnitude);}
+        if(output.invariant_mass)
+        {
+          const __m256d e = _mm256_loadu_pd(energy + i);
+          const __m256d mass_squared = _mm256_sub_pd(_mm256_mul_pd(e, e), momentum_squared);
+          const __m256d rounding = _mm256_and_pd(_mm256_cmp_pd(mass_squared, zero, _CMP_LT_OQ),
+            _mm256_cmp_pd(mass_squared, tolerance, _CMP_GT_OQ));
+          _mm256_storeu_pd(output.invariant_mass + i,
+            _mm256_blendv_pd(_mm256_sqrt_pd(mass_squared), zero, rounding));
+        }
+        if(output.pseudorapidity)
+        {
+          const __m256d ratio = _mm256_div_pd(_mm256_add_pd(momentum_magnitude, _mm256_andnot_pd(sign_bit, z)),
+            transverse_momentum);
+          // Infinite (beam axis) and NaN ratios are their own logarithm
+          const __m256d special = _mm256_cmp_pd(ratio, infinity, _CMP_NLT_UQ);
+          const __m256d log_ratio = _mm256_blendv_pd(log_avx2(ratio), ratio, special);
+          const __m256d eta = _mm256_or_pd(_mm256_andnot_pd(sign_bit, log_ratio), _mm256_and_pd(sign_bit, z));
+          const __m256d at_rest = _mm256_cmp_pd(momentum_magnitude, _mm256_set1_pd(minimum_momentum), _CMP_LT_OQ);
+          _mm256_storeu_pd(output.pseudorapidity + i, _mm256_blendv_pd(eta, zero, at_rest));
+        }
+        if(output.azimuthal_angle)
+        {
+          _mm256_storeu_pd(output.azimuthal_angle + i, atan2_avx2(y, x));
+          // Zero, infinite and NaN components follow the special cases of std::atan2
+          const __m256d finite_x = _mm256_and_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign_bit, x), zero, _CMP_GT_OQ),
+            _mm256_cmp_pd(_mm256_andnot_pd(sign_bit, x), infinity, _CMP_LT_OQ));
+          const __m256d finite_y = _mm256_and_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign_bit, y), zero, _CMP_GT_OQ),
+            _mm256_cmp_pd(_mm256_andnot_pd(sign_bit, y), infinity, _CMP_LT_OQ));
+          if(_mm256_movemask_pd(_mm256_and_pd(finite_x, finite_y)) != 0xF)
+          {
+            for(std::size_t k = i; k < i + 4; ++k) {output.azimuthal_angle[k] = std::atan2(py[k], px[k]);}
+          }
+        }
+      }
+      kinematics_scalar(px, py, pz, energy, i, count, output);
+    }
+
+    // GCC 12 reports the intentionally undefined pass-through operand of the unmasked AVX-512
+    // intrinsics (_mm512_sqrt_pd, _mm512_srli_epi64) as possibly uninitialised
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+    // Natural logarithm of eight finite values x >= 1
+    __attribute__((target("avx512f"), optimize("fp-contract=off")))
+    inline __m512d log_avx512(__m512d x)
+    {
+      const __m512i bits = _mm512_castpd_si512(x);
+      __m512i exponent = _mm512_sub_epi64(_mm512_srli_epi64(bits, 52), _mm512_set1_epi64(1023));
+      __m512d mantissa = _mm512_castsi512_pd(_mm512_or_si512(
+        _mm512_and_si512(bits, _mm512_set1_epi64(mantissa_bits)), _mm512_set1_epi64(exponent_of_one)));
+      // Move mantissas above √2 to [√½, 1) and raise their exponent by one
+      const __mmask8 large = _mm512_cmp_pd_mask(mantissa, _mm512_set1_pd(square_root_of_two), _CMP_GT_OQ);
+      mantissa = _mm512_mask_mul_pd(mantissa, large, mantissa, _mm512_set1_pd(0.5));
+      exponent = _mm512_mask_add_epi64(exponent, large, exponent, _mm512_set1_epi64(1));
+      const __m512d scale = _mm512_sub_pd(_mm512_castsi512_pd(
+        _mm512_add_epi64(exponent, _mm512_set1_epi64(two_to_52_bits))), _mm512_set1_pd(two_to_52));
+      const __m512d one = _mm512_set1_pd(1.0);
+      const __m512d s = _mm512_div_pd(_mm512_sub_pd(mantissa, one), _mm512_add_pd(mantissa, one));
+      const __m512d s_squared = _mm512_mul_pd(s, s);
+      __m512d series = _mm512_set1_pd(log_series[0]);
+      for(std::size_t k = 1; k < sizeof(log_series) / sizeof(log_series[0]); ++k)
+      {
+        series = _mm512_add_pd(_mm512_mul_pd(series, s_squared), _mm512_set1_pd(log_series[k]));
+      }
+      const __m512d log_mantissa = _mm512_mul_pd(s, series);
+      return _mm512_add_pd(_mm512_mul_pd(scale, _mm512_set1_pd(ln2_high)),
+        _mm512_add_pd(_mm512_mul_pd(scale, _mm512_set1_pd(ln2_low)), log_mantissa));
+    }
+
+    // Same as atan2_avx2 for eight values
+    __attribute__((target("avx512f"), optimize("fp-contract=off")))
+    inline __m512d atan2_avx512(__m512d y, __m512d x)
+    {
+      const __m512d one = _mm512_set1_pd(1.0);
+      const __m512d zero = _mm512_setzero_pd();
+      const __m512d ratio = _mm512_div_pd(_mm512_abs_pd(y), _mm512_abs_pd(x));
+      const __mmask8 large = _mm512_cmp_pd_mask(ratio, _mm512_set1_pd(tan_three_pi_over_8), _CMP_GT_OQ);
+      const __mmask8 medium = static_cast<__mmask8>(~large & _mm512_cmp_pd_mask(ratio, _mm512_set1_pd(0.66), _CMP_GT_OQ));
+      const __m512d numerator = _mm512_mask_blend_pd(large,
+        _mm512_mask_blend_pd(medium, ratio, _mm512_sub_pd(ratio, one)), _mm512_set1_pd(-1.0));
+      const __m512d denominator = _mm512_mask_blend_pd(large,
+        _mm512_mask_blend_pd(medium, one, _mm512_add_pd(ratio, one)), ratio);
+      const __m512d reduced = _mm512_div_pd(numerator, denominator);
+      const __m512d base = _mm512_mask_blend_pd(large,
+        _mm512_mask_blend_pd(medium, zero, _mm512_set1_pd(pi_over_4)), _mm512_set1_pd(pi_over_2));
+      const __m512d base_low = _mm512_mask_blend_pd(large,
+        _mm512_mask_blend_pd(medium, zero, _mm512_set1_pd(0.5 * pi_over_2_low)), _mm512_set1_pd(pi_over_2_low));
+      const __m512d z = _mm512_mul_pd(reduced, reduced);
+      __m512d p = _mm512_set1_pd(atan_numerator[0]);
+      __m512d q = _mm512_add_pd(z, _mm512_set1_pd(atan_denominator[0]));
+      for(std::size_t k = 1; k < sizeof(atan_numerator) / sizeof(atan_numerator[0]); ++k)
+      {
+        p = _mm512_add_pd(_mm512_mul_pd(p, z), _mm512_set1_pd(atan_numerator[k]));
+        q = _mm512_add_pd(_mm512_mul_pd(q, z), _mm512_set1_pd(atan_denominator[k]));
+      }
+      const __m512d correction = _mm512_add_pd(_mm512_mul_pd(reduced, _mm512_div_pd(_mm512_mul_pd(z, p), q)), reduced);
+      __m512d angle = _mm512_add_pd(base, _mm512_add_pd(correction, base_low));
+      const __mmask8 negative_x = _mm512_cmp_pd_mask(x, zero, _CMP_LT_OQ);
+      angle = _mm512_mask_blend_pd(negative_x, angle,
+        _mm512_add_pd(_mm512_sub_pd(_mm512_set1_pd(pi), angle), _mm512_set1_pd(pi_low)));
+      const __m512i sign_bit = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ULL));
+      return _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(angle),
+        _mm512_and_si512(_mm512_castpd_si512(y), sign_bit)));
+    }
+
+    // Eight particles per iteration; the tail uses masked loads and stores
+    __attribute__((target("avx512f"), optimize("fp-contract=off")))
+    void kinematics_avx512(const double* px, const double* py, const double* pz, const double* energy,
+      std::size_t count, const KinematicsOutput& output)
+    {
+      const __m512d infinity = _mm512_set1_pd(std::numeric_limits<double>::infinity());
+      const __m512i sign_bit = _mm512_set1_epi64(static_cast<long long>(0x8000000000000000ULL));
+      const __m512d zero = _mm512_setzero_pd();
+      for(std::size_t i = 0; i < count; i += 8)
+      {
+        const std::size_t remaining = count - i;
+        const __mmask8 lanes = remaining >= 8 ? 0xFF : static_cast<__mmask8>((1u << remaining) - 1);
+        const __m512d x = _mm512_maskz_loadu_pd(lanes, px + i);
+        const __m512d y = _mm512_maskz_loadu_pd(lanes, py + i);
+        const __m512d z = _mm512_maskz_loadu_pd(lanes, pz + i);
+        const __m512d transverse_squared = _mm512_add_pd(_mm512_mul_pd(x, x), _mm512_mul_pd(y, y));
+        const __m512d momentum_squared = _mm512_add_pd(transverse_squared, _mm512_mul_pd(z, z));
+        const __m512d transverse_momentum = _mm512_sqrt_pd(transverse_squared);
+        const __m512d momentum_magnitude = _mm512_sqrt_pd(momentum_squared);
+        if(output.transverse_momentum) {_mm512_mask_storeu_pd(output.transverse_momentum + i, lanes, transverse_momentum);}
+        if(output.momentum_magnitude) {_mm512_mask_storeu_pd(output.momentum_magnitude + i, lanes, momentum_magnitude);}
+        if(output.invariant_mass)
+        {
+          const __m512d e = _mm512_maskz_loadu_pd(lanes, energy + i);
+          const __m512d mass_squared = _mm512_sub_pd(_mm512_mul_pd(e, e), momentum_squared);
+          const __mmask8 rounding = _mm512_cmp_pd_mask(mass_squared, zero, _CMP_LT_OQ) &
+            _mm512_cmp_pd_mask(mass_squared, _mm512_set1_pd(-mass_squared_tolerance), _CMP_GT_OQ);
+          _mm512_mask_storeu_pd(output.invariant_mass + i, lanes,
+            _mm512_mask_blend_pd(rounding, _mm512_sqrt_pd(mass_squared), zero));
+        }
+        if(output.pseudorapidity)
+        {
+          const __m512d ratio = _mm512_div_pd(_mm512_add_pd(momentum_magnitude, _mm512_abs_pd(z)),
+            transverse_momentum);
+          // Infinite (beam axis) and NaN ratios are their own logarithm
+          const __mmask8 special = _mm512_cmp_pd_mask(ratio, infinity, _CMP_NLT_UQ);
+          const __m512d log_ratio = _mm512_mask_blend_pd(special, log_avx512(ratio), ratio);
+          // Copy the sign of pz onto the (non-negative) logarithm
+          const __m512d eta = _mm512_castsi512_pd(_mm512_or_si512(_mm512_castpd_si512(_mm512_abs_pd(log_ratio)),
+            _mm512_and_si512(_mm512_castpd_si512(z), sign_bit)));
+          const __mmask8 at_rest = _mm512_cmp_pd_mask(momentum_magnitude, _mm512_set1_pd(minimum_momentum), _CMP_LT_OQ);
+          _mm512_mask_storeu_pd(output.pseudorapidity + i, lanes, _mm512_mask_blend_pd(at_rest, eta, zero));
+        }
+        if(output.azimuthal_angle)
+        {
+          _mm512_mask_storeu_pd(output.azimuthal_angle + i, lanes, atan2_avx512(y, x));
+          // Zero, infinite and NaN components follow the special cases of std::atan2
+          const __mmask8 finite = _mm512_cmp_pd_mask(_mm512_abs_pd(x), zero, _CMP_GT_OQ) &
+            _mm512_cmp_pd_mask(_mm512_abs_pd(x), infinity, _CMP_LT_OQ) &
+            _mm512_cmp_pd_mask(_mm512_abs_pd(y), zero, _CMP_GT_OQ) &
+            _mm512_cmp_pd_mask(_mm512_abs_pd(y), infinity, _CMP_LT_OQ);
+          if((finite & lanes) != lanes)
+          {
+            for(std::size_t k = i; k < i + 8 && k < count; ++k) {output.azimuthal_angle[k] = std::atan2(py[k], px[k]);}
+          }
+        }
+      }
+    }
+#pragma GCC diagnostic pop
+#endif
+  }
+
+  void compute_kinematics(const double* px, const double* py, const double* pz, const double* energy,
+    std::size_t count, const KinematicsOutput& output)
+  {
+#if PARTICLE_DETECTOR_X86_SIMD
+    switch(DetectorSimd::active_simd_level())
+    {
+      case DetectorSimd::SimdLevel::AVX512:
+        kinematics_avx512(px, py, pz, energy, count, output);
+        return;
+      case DetectorSimd::SimdLevel::AVX2:
+        kinematics_avx2(px, py, pz, energy, count, output);
+        return;
+      case DetectorSimd::SimdLevel::Scalar:
+        break;
+    }
+#endif
+    kinematics_scalar(px, py, pz, energy, 0, count, output);
+  }
+
+  double pseudorapidity(double px, double py, double pz)
+  {
+    const double transverse_squared = px * px + py * py;
+    return pseudorapidity_from(std::sqrt(transverse_squared), std::sqrt(transverse_squared + pz * pz), pz);
+  }
+} // namespace ParticleProperties
@@ -0,0 +1,198 @@
+// LheReader.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the streaming LheReader class. Lines are located with memchr in
+// the chunk buffer and numbers are converted in place with std::from_chars; the only
+// allocation while reading is the growth of the buffer if a line is longer than a chunk.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<charconv>
+#include<cmath>
+#include<cstring>
+#include<limits>
+#include<stdexcept>
+
+#include "LheReader.h"
+#include "PdgMapping.h"
+
+using namespace ParticleSystem;
+
+namespace
+{
+  // Skip spaces and tabs
+  const char* skip_blanks(const char* position, const char* end)
+  {
+    while(position < end && (*position == ' ' || *position == '\t')) {++position;}
+    return position;
+  }
+
+  // Parse the next whitespace-separated number of a line and advance past it.
+  // Generators often write an explicit '+' sign, which std::from_chars does not accept.
+  template<typename T> bool parse_field(const char*& position, const char* end, T& value)
+  {
+    position = skip_blanks(position, end);
+    if(position < end && *position == '+') {++position;}
+    const auto result = std::from_chars(position, end, value);
+    if(result.ec != std::errc()) {return false;}
+    position = result.ptr;
+    return true;
+  }
+
+  // Check if a line starts with an XML tag name, e.g. "<event" matches "<event>" and
+  // "<event attribute=...>" but not "<eventgroup>"
+  bool starts_with_tag(const char* line_begin, const char* line_end, const char* tag)
+  {
+    line_begin = skip_blanks(line_begin, line_end);
+    const std::size_t tag_length = std::strlen(tag);
+    if(static_cast<std::size_t>(line_end - line_begin) < tag_length) {return false;}
+    if(std::memcmp(line_begin, tag, tag_length) != 0) {return false;}
+    if(line_begin + tag_length == line_end) {return true;}
+    const char next = line_begin[tag_length];
+    return next == '>' || next == ' ' || next == '\t' || next == '/';
+  }
+}
+
+// [RULE OF 5]
+
+LheReader::LheReader(const std::string& name, std::size_t chunk_size) :
+  file_name{name}, file{nullptr}, buffer(chunk_size == 0 ? default_chunk_size : chunk_size),
+  read_position{0}, buffer_end{0}, end_of_file{false}, end_of_events{false}, line_number{0},
+  events_read{0}, particles_read{0}, particles_skipped{0}
+{
+  file = std::fopen(file_name.c_str(), "rb");
+  if(file == nullptr) {throw std::runtime_error("Error: Cannot open LHE file " + file_name);}
+  // The reader does its own chunked buffering
+  std::setvbuf(file, nullptr, _IONBF, 0);
+}
+
+LheReader::~LheReader()
+{
+  std::fclose(file);
+}
+
+// [PRIVATE METHODS]
+
+bool LheReader::next_line(const char*& line_begin, const char*& line_end)
+{
+  while(true)
+  {
+    const char* start = buffer.data() + read_position;
+    const char* stop = buffer.data() + buffer_end;
+    const char* newline = static_cast<const char*>(std::memchr(start, '\n', static_cast<std::size_t>(stop - start)));
+    if(newline != nullptr || (end_of_file && start < stop))
+    {
+      line_begin = start;
+      line_end = newline != nullptr ? newline : stop;
+      read_position = static_cast<std::size_t>(line_end - buffer.data()) + (newline != nullptr ? 1 : 0);
+      // Accept Windows line endings
+      if(line_end > line_begin && line_end[-1] == '\r') {--line_end;}
+      ++line_number;
+      return true;
+    }
+    if(end_of_file) {return false;}
+    // Move the incomplete line to the front of the buffer and read the next chunk behind it
+    const std::size_t remaining = buffer_end - read_position;
+    std::memmove(buffer.data(), start, remaining);
+    read_position = 0;
+    buffer_end = remaining;
+    // A line longer than the buffer needs a larger buffer
+    if(buffer_end == buffer.size()) {buffer.resize(buffer.size() * 2);}
+    const std::size_t bytes_read = std::fread(buffer.data() + buffer_end, 1, buffer.size() - buffer_end, file);
+    if(bytes_read == 0)
+    {
+      if(std::ferror(file)) {throw std::runtime_error("Error: Failed to read LHE file " + file_name);}
+      end_of_file = true;
+    }
+    buffer_end += bytes_read;
+  }
+}
+
+void LheReader::throw_parse_error(const std::string& message) const
+{
+  throw std::runtime_error("Error: " + message + " in LHE file " + file_name + " at line " +
+    std::to_string(line_number));
+}
+
+void LheReader::read_event(ParticleBatch& batch)
+{
+  const char* line_begin;
+  const char* line_end;
+  // Event information line: NUP IDPRUP XWGTUP SCALUP AQEDUP AQCDUP (only NUP is used)
+  if(!next_line(line_begin, line_end)) {throw_parse_error("Unexpected end of file inside an event");}
+  int number_of_entries = 0;
+  if(!parse_field(line_begin, line_end, number_of_entries) || number_of_entries < 0)
+  {
+    throw_parse_error("Invalid number of particles");
+  }
+  for(int entry = 0; entry < number_of_entries; ++entry)
+  {
+    if(!next_line(line_begin, line_end)) {throw_parse_error("Unexpected end of file inside an event");}
+    int pdg_id = 0, status = 0, mother_1 = 0, mother_2 = 0, colour_1 = 0, colour_2 = 0;
+    double px = 0.0, py = 0.0, pz = 0.0, energy = 0.0;
+    if(!(parse_field(line_begin, line_end, pdg_id) && parse_field(line_begin, line_end, status) &&
+      parse_field(line_begin, line_end, mother_1) && parse_field(line_begin, line_end, mother_2) &&
+      parse_field(line_begin, line_end, colour_1) && parse_field(line_begin, line_end, colour_2) &&
+      parse_field(line_begin, line_end, px) && parse_field(line_begin, line_end, py) &&
+      parse_field(line_begin, line_end, pz) && parse_field(line_begin, line_end, energy)))
+    {
+      throw_parse_error("Invalid particle line");
+    }
+    // Only final-state particles reach the detector
+    if(status != 1) {continue;}
+    ParticleType type = ParticleType::Hadron;
+    double charge = 0.0;
+    if(!particle_type_from_pdg_id(pdg_id, type, charge))
+    {
+      ++particles_skipped;
+      continue;
+    }
+    // Generators print massless momenta with limited precision, so E can fall just below |p|
+    const double momentum_squared = px * px + py * py + pz * pz;
+    if(energy >= 0.0 && energy * energy < momentum_squared)
+    {
+      const double momentum = std::sqrt(momentum_squared);
+      if(momentum - energy <= 1e-7 * momentum)
+      {
+        energy = std::nextafter(momentum, std::numeric_limits<double>::infinity());
+      }
+    }
+    try {batch.add_particle(type, charge, px, py, pz, energy);}
+    catch(const std::invalid_argument&) {throw_parse_error("Unphysical four-momentum");}
+    ++particles_read;
+  }
+  // Skip optional information (weights, comments) up to the closing tag
+  while(true)
+  {
+    if(!next_line(line_begin, line_end)) {throw_parse_error("Missing </event> tag");}
+    if(starts_with_tag(line_begin, line_end, "</event")) {break;}
+  }
+  batch.end_event();
+}
+
+// [METHODS]
+
+std::size_t LheReader::read_events(ParticleBatch& batch, std::size_t max_events)
+{
+  if(batch.number_of_events() == 0) {batch.first_event_number = events_read;}
+  std::size_t events_appended = 0;
+  const char* line_begin;
+  const char* line_end;
+  while(events_appended < max_events && !end_of_events)
+  {
+    if(!next_line(line_begin, line_end) || starts_with_tag(line_begin, line_end, "</LesHouchesEvents"))
+    {
+      end_of_events = true;
+      break;
+    }
+    if(!starts_with_tag(line_begin, line_end, "<event")) {continue;}
+    read_event(batch);
+    ++events_appended;
+    ++events_read;
+  }
+  return events_appended;
+}
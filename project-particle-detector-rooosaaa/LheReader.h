@@ -0,0 +1,93 @@
+// LheReader.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Header file for the LheReader class, a streaming reader for Les Houches Event (LHE)
+// files written by Monte Carlo event generators. Each `<event>` block holds one line of
+// event information followed by one line per particle:
+//
+//   IDUP ISTUP MOTHUP(1) MOTHUP(2) ICOLUP(1) ICOLUP(2) PUP(1..5) VTIMUP SPINUP
+//
+// Only final-state particles (ISTUP = 1) are kept. Their PDG numbers are mapped onto the
+// particle types of this project (see PdgMapping.h) and appended to a ParticleBatch, one
+// batch event per LHE event; final-state particles without an equivalent type are skipped
+// and counted.
+//
+// The file is read in large chunks into a single buffer and parsed in place with
+// std::from_chars, so no std::string or stream object is created per line or per number.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef LHE_READER_H
+#define LHE_READER_H
+
+#include<cstddef>
+#include<cstdint>
+#include<cstdio>
+#include<string>
+#include<vector>
+
+#include "ParticleBatch.h"
+
+namespace ParticleSystem
+{
+  class LheReader
+  {
+  private:
+    std::string file_name;
+    std::FILE* file;
+    std::vector<char> buffer; // chunk buffer; unread data is [read_position, buffer_end)
+    std::size_t read_position;
+    std::size_t buffer_end;
+    bool end_of_file; // no more data to read from the file
+    bool end_of_events; // closing </LesHouchesEvents> tag (or the end of the file) reached
+    std::uint64_t line_number;
+    std::uint64_t events_read;
+    std::uint64_t particles_read;
+    std::uint64_t particles_skipped;
+    // Return the next line (without the line ending) as a range of the buffer, which stays
+    // valid until the next call; returns false at the end of the file
+    bool next_line(const char*& line_begin, const char*& line_end);
+    // Parse one event after its <event> tag and append its final-state particles
+    void read_event(ParticleBatch& batch);
+    // Throw a parse error pointing at the current line
+    [[noreturn]] void throw_parse_error(const std::string& message) const;
+
+  public:
+    // Default size of the chunks read from the file
+    static constexpr std::size_t default_chunk_size = 1 << 22;
+
+    // [RULE OF 5]
+    // Parameterised constructor: opens the file
+    explicit LheReader(const std::string& name, std::size_t chunk_size = default_chunk_size);
+    // Not allowing copy or move operations as the reader owns the open file
+    // Copy constructor
+    LheReader(const LheReader& other) = delete;
+    // Move constructor
+    LheReader(LheReader&& other) = delete;
+    // Copy assignment operator
+    LheReader& operator=(const LheReader& other) = delete;
+    // Move assignment operator
+    LheReader& operator=(LheReader&& other) = delete;
+    // Destructor
+    ~LheReader();
+
+    // [GETTERS]
+    const std::string& get_file_name() const {return file_name;}
+    std::uint64_t number_of_events_read() const {return events_read;}
+    std::uint64_t number_of_particles_read() const {return particles_read;}
+    std::uint64_t number_of_particles_skipped() const {return particles_skipped;}
+    bool at_end() const {return end_of_events;}
+
+    // [METHODS]
+    // Append up to `max_events` events to the batch and return the number appended
+    // (0 once every event has been read). If the batch holds no events yet, its
+    // first_event_number is set to the number of the next event in the file.
+    std::size_t read_events(ParticleBatch& batch, std::size_t max_events);
+  };
+} // namespace ParticleSystem
+
+#endif // LHE_READER_H
@@ -0,0 +1,34 @@
+// Logging.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the logging facility. It stores the runtime log level, which is
+// shared by all threads and therefore kept in an atomic variable.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<atomic>
+
+#include "Logging.h"
+
+namespace DetectorLogging
+{
+  namespace
+  {
+    // Runtime level, starts at the most verbose level compiled into the program
+    std::atomic<int> runtime_log_level{PARTICLE_DETECTOR_LOG_LEVEL};
+  }
+
+  LogLevel get_log_level()
+  {
+    return static_cast<LogLevel>(runtime_log_level.load(std::memory_order_relaxed));
+  }
+
+  void set_log_level(LogLevel level)
+  {
+    runtime_log_level.store(static_cast<int>(level), std::memory_order_relaxed);
+  }
+} // namespace DetectorLogging
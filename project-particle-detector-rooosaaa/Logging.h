@@ -0,0 +1,67 @@
+// Logging.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines a small logging facility for the diagnostic console messages of
+// the simulation (constructor/destructor chatter, detector status changes, etc.).
+//
+// Messages have a level, and are filtered twice:
+// - At compile time by PARTICLE_DETECTOR_LOG_LEVEL (0 = none, 1 = info, 2 = debug).
+//   Messages above this level are removed entirely, so a production build compiled with
+//   -DPARTICLE_DETECTOR_LOG_LEVEL=0 performs no console I/O on these paths.
+// - At run time by set_log_level, which can only lower the verbosity of a build.
+//
+// The default compile-time level is 2, so a normal build prints the same messages as before.
+// Report-style output (e.g. Detector::print_detection_results) is not routed through here.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef LOGGING_H
+#define LOGGING_H
+
+#include<iostream>
+
+// Highest message level compiled into the program
+#ifndef PARTICLE_DETECTOR_LOG_LEVEL
+#define PARTICLE_DETECTOR_LOG_LEVEL 2
+#endif
+
+namespace DetectorLogging
+{
+  // Verbosity levels, from quietest to most verbose
+  enum class LogLevel : int
+  {
+    None = 0, // No diagnostic messages
+    Info = 1, // Detector status and progress messages
+    Debug = 2 // Object lifetime messages (constructors, destructors, copies and moves)
+  };
+
+  // [RUNTIME LEVEL]
+  // Get the current runtime level (defaults to the compile-time level)
+  LogLevel get_log_level();
+  // Set the runtime level; levels above PARTICLE_DETECTOR_LOG_LEVEL still print nothing
+  void set_log_level(LogLevel level);
+  // Check if a message of the given level would currently be printed
+  inline bool is_enabled(LogLevel level)
+  {
+    return static_cast<int>(level) <= PARTICLE_DETECTOR_LOG_LEVEL &&
+      static_cast<int>(level) <= static_cast<int>(get_log_level());
+  }
+} // namespace DetectorLogging
+
+// Print a message of the given level. The compile-time check is a constant expression, so
+// disabled levels compile to nothing and the message expression is never evaluated.
+#define DETECTOR_LOG(level, message) \
+  do \
+  { \
+    if(static_cast<int>(level) <= PARTICLE_DETECTOR_LOG_LEVEL && DetectorLogging::is_enabled(level)) \
+      {std::cout<<message<<std::endl;} \
+  } while(false)
+
+#define DETECTOR_LOG_INFO(message) DETECTOR_LOG(DetectorLogging::LogLevel::Info, message)
+#define DETECTOR_LOG_DEBUG(message) DETECTOR_LOG(DetectorLogging::LogLevel::Debug, message)
+
+#endif // LOGGING_H
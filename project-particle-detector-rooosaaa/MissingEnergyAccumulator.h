@@ -0,0 +1,137 @@
+// MissingEnergyAccumulator.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `MissingEnergyAccumulator` class, which computes the
+// missing transverse energy (MET) and the visible energy of an event incrementally. It is
+// fed one particle at a time as soon as the particle has been detected, so neither the
+// particles nor their readings need to be kept until the end of the event, and its size
+// does not depend on the number of particles (for example in 1000-particle pileup events).
+//
+// Definitions (the same as Detector::calculate_missing_energy):
+// - the true totals are the sums of the true four-momenta
+// - the detected energy of a particle is its last non-zero reading, and its detected
+//   momentum is the true momentum scaled by detected / true energy
+// - MET is the magnitude of the summed transverse momentum
+//
+// Every sum uses Neumaier (improved Kahan) compensated summation, so the result stays
+// accurate when large momenta that nearly cancel are added to many small ones.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef MISSING_ENERGY_ACCUMULATOR_H
+#define MISSING_ENERGY_ACCUMULATOR_H
+
+#include<cmath>
+#include<cstddef>
+
+#include "DetectorReadings.h"
+#include "FourMomentum.h"
+#include "Particle.h"
+
+namespace ParticleDetector
+{
+  // Neumaier compensated sum: the rounding error of every addition is kept in a separate
+  // compensation term, which is added back when the value is read
+  class CompensatedSum
+  {
+  private:
+    double sum{0.0};
+    double compensation{0.0};
+
+  public:
+    void add(double value)
+    {
+      const double total = sum + value;
+      if(std::abs(sum) >= std::abs(value)) {compensation += (sum - total) + value;}
+      else {compensation += (value - total) + sum;}
+      sum = total;
+    }
+    void add(const CompensatedSum& other)
+    {
+      add(other.sum);
+      compensation += other.compensation;
+    }
+    double get_value() const {return sum + compensation;}
+  };
+
+  class MissingEnergyAccumulator
+  {
+  private:
+    CompensatedSum true_px, true_py, true_pz, true_energy;
+    CompensatedSum detected_px, detected_py, detected_energy;
+    std::size_t number_of_particles{0};
+
+    static double transverse_magnitude(const CompensatedSum& x, const CompensatedSum& y)
+    {
+      const double px = x.get_value();
+      const double py = y.get_value();
+      return std::sqrt(px * px + py * py);
+    }
+
+  public:
+    // [METHODS]
+    // Add a particle from its true momentum components and energy and its detected energy
+    void add_particle(double px, double py, double pz, double energy, double particle_detected_energy)
+    {
+      true_px.add(px);
+      true_py.add(py);
+      true_pz.add(pz);
+      true_energy.add(energy);
+      // Assumes the direction is preserved and only the magnitude is reduced by the detector
+      if(energy > 0)
+      {
+        const double scale = particle_detected_energy / energy;
+        detected_px.add(px * scale);
+        detected_py.add(py * scale);
+      }
+      detected_energy.add(particle_detected_energy);
+      ++number_of_particles;
+    }
+    void add_particle(const ParticleProperties::FourMomentum& momentum, double particle_detected_energy)
+    {
+      add_particle(momentum.get_px(), momentum.get_py(), momentum.get_pz(), momentum.get_energy(),
+        particle_detected_energy);
+    }
+    // Add a particle together with its detector readings
+    void add_particle(const ParticleSystem::Particle& particle, const DetectorReadings& readings)
+    {
+      add_particle(particle.get_momentum(), readings.get_detected_energy());
+    }
+    // Add the totals of another accumulator, e.g. one filled by another thread
+    void merge(const MissingEnergyAccumulator& other)
+    {
+      true_px.add(other.true_px);
+      true_py.add(other.true_py);
+      true_pz.add(other.true_pz);
+      true_energy.add(other.true_energy);
+      detected_px.add(other.detected_px);
+      detected_py.add(other.detected_py);
+      detected_energy.add(other.detected_energy);
+      number_of_particles += other.number_of_particles;
+    }
+    // Start a new event
+    void reset() {*this = MissingEnergyAccumulator();}
+
+    // [GETTERS]
+    std::size_t get_number_of_particles() const {return number_of_particles;}
+    double get_true_energy() const {return true_energy.get_value();}
+    double get_detected_energy() const {return detected_energy.get_value();}
+    double get_true_met() const {return transverse_magnitude(true_px, true_py);}
+    double get_detected_met() const {return transverse_magnitude(detected_px, detected_py);}
+    // Invariant mass of the summed true four-momenta, with the rounding rule of
+    // FourMomentum::calculate_invariant_mass for massless systems
+    double get_invariant_mass() const
+    {
+      const double px = true_px.get_value(), py = true_py.get_value(), pz = true_pz.get_value();
+      const double energy = true_energy.get_value();
+      const double mass_squared = energy * energy - (px * px + py * py + pz * pz);
+      return (mass_squared < 0 && mass_squared > -1e-10) ? 0.0 : std::sqrt(mass_squared);
+    }
+  };
+} // namespace ParticleDetector
+
+#endif // MISSING_ENERGY_ACCUMULATOR_H
@@ -7,7 +7,6 @@
 // and behaviors of muon particles within the particle detector simulation. It includes the:
 // - Rule of 5 for proper memory management,
 // - Methods for setting and printing properties
-// - Method for detecting muons in specific detectors.
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -16,6 +15,7 @@
 #include<iostream>
 
 #include "Muon.h"
+#include "Logging.h"
 
 using namespace ParticleSystem;
 
@@ -28,12 +28,12 @@ Muon::Muon(int id, const FourMomentum& momentum) : Particle("Muon", id, momentum
 
 Muon::~Muon()
 {
-  std::cout<<"Muon destructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Muon destructor called.");
 }
 
 Muon::Muon(const Muon& other) : Particle(other)
 {
-  std::cout<<"Muon copy constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Muon copy constructor called.");
   // Copy the muon properties
   particle_name = other.particle_name;
   particle_four_momentum = other.particle_four_momentum;
@@ -43,7 +43,7 @@ Muon::Muon(const Muon& other) : Particle(other)
 
 Muon::Muon(Muon&& other) noexcept : Particle(std::move(other))
 {
-  std::cout<<"Muon move constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Muon move constructor called.");
   // Move the muon properties
   particle_name = std::move(other.particle_name);
   // Call move assignment operator for FourMomentum
@@ -57,7 +57,7 @@ Muon::Muon(Muon&& other) noexcept : Particle(std::move(other))
 
 Muon& Muon::operator=(const Muon& other)
 {
-  std::cout<<"Muon copy assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Muon copy assignment operator called.");
   if(this != &other)
   {
     // Copy the muon properties
@@ -71,7 +71,7 @@ Muon& Muon::operator=(const Muon& other)
 
 Muon& Muon::operator=(Muon&& other) noexcept
 {
-  std::cout<<"Muon move assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Muon move assignment operator called.");
   if(this != &other)
   {
     // Move the muon properties
@@ -111,11 +111,3 @@ void Muon::print() const
   std::cout<<"ID: "<<particle_id<<std::endl;
   std::cout<<"Charge (e): "<<particle_charge<<std::endl;
 }
-
-// Detection method
-bool Muon::can_be_detected_by(const std::string& detector_type) const
-{
-  // Example logic for muon detection
-  if(detector_type == "Muon Spectrometer" || detector_type == "Tracker") {return true;}
-  else {return false;}
-}
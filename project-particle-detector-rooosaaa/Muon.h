@@ -9,8 +9,9 @@
 // The `Muon` class includes:
 // - Rule of 5 methods for proper memory management
 // - Setter methods for the name and charge of the muon, with validation
-// - Methods for printing the muon's properties and checking detection compatibility with various detector
-//   types
+// - Methods for printing the muon's properties
+// - A `get_type` method returning the muon type code, which determines the sub-detectors that can
+//   detect it (see DetectionCapability.h)
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -44,16 +45,15 @@ namespace ParticleSystem
     // Destructor
     ~Muon();
 
+    // [GETTERS]
+    ParticleType get_type() const override {return ParticleType::Muon;}
+
     // [SETTERS]
     void set_name(std::string name) override;
     void set_charge(double charge) override;
     
     // [PRINT METHOD]
     void print() const override;
-    
-    // [DETECTION METHOD]
-    // Method to check if particle can be detected by a detector type
-    bool can_be_detected_by(const std::string& detector_type) const override;
   };
 } // namespace ParticleSystem
 
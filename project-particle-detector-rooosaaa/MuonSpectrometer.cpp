@@ -21,6 +21,7 @@
 #include<map>
 
 #include "MuonSpectrometer.h"
+#include "Logging.h"
 
 using namespace DetectorSubsystems;
 
@@ -29,7 +30,7 @@ using namespace DetectorSubsystems;
 // Default constructor: perfect resolution and no energy loss
 MuonSpectrometer::MuonSpectrometer() : SubDetector("Muon Spectrometer", 0, 1)
 {
-  std::cout<<"Calling MuonSpectrometer parametrised constructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling MuonSpectrometer parametrised constructor.");
   std::list<std::string> chambers = {"MDT", "RPC", "TGC", "CSC"};
   set_chamber_types(chambers);
 }
@@ -43,7 +44,7 @@ MuonSpectrometer::MuonSpectrometer(int resolution, double energy_loss, std::list
 
 MuonSpectrometer::~MuonSpectrometer()
 {
-  std::cout<<"Calling MuonSpectrometer destructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling MuonSpectrometer destructor.");
 }
 
 // [SETTERS]
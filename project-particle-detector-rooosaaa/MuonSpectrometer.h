@@ -36,6 +36,9 @@ namespace DetectorSubsystems
     // Any additional properties of the Muon Spectrometer can be added here
       
   public:
+    // Compile-time type code of this sub-detector, used by StaticDetector
+    static constexpr SubDetectorType static_type_id = SubDetectorType::MuonSpectrometer;
+
     // [RULE OF 5]
     // Default constructor - resolution is set to 0 and energy loss to 1 (perfect Muon Spectrometer)
     MuonSpectrometer();
@@ -12,7 +12,7 @@
 // - Implementation of the Rule of 5 (constructors, assignment operators, destructor)
 // - Proper handling of neutrino-specific properties like name ("Neutrino") and charge (0)
 // - The `print` method outputs neutrino properties, including its four-momentum and ID
-// - The `can_be_detected_by` method checks that neutrinos cannot be detected by typical detectors
+// - Detection capability is defined by the particle type (see DetectionCapability.h)
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -21,6 +21,7 @@
 #include<iostream>
 
 #include "Neutrino.h"
+#include "Logging.h"
 
 using namespace ParticleSystem;
 
@@ -33,12 +34,12 @@ Neutrino::Neutrino(int id, const FourMomentum& momentum)  : Particle("Neutrino",
 
 Neutrino::~Neutrino()
 {
-  std::cout<<"Neutrino destructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Neutrino destructor called.");
 }
 
 Neutrino::Neutrino(const Neutrino& other) : Particle(other)
 {
-  std::cout<<"Neutrino copy constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Neutrino copy constructor called.");
   // Copy the neutrino properties
   particle_name = other.particle_name;
   particle_four_momentum = other.particle_four_momentum;
@@ -48,7 +49,7 @@ Neutrino::Neutrino(const Neutrino& other) : Particle(other)
 
 Neutrino::Neutrino(Neutrino&& other) noexcept : Particle(std::move(other))
 {
-  std::cout<<"Neutrino move constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Neutrino move constructor called.");
   // Move the neutrino properties
   particle_name = std::move(other.particle_name);
   // Call move assignment operator for FourMomentum
@@ -62,7 +63,7 @@ Neutrino::Neutrino(Neutrino&& other) noexcept : Particle(std::move(other))
 
 Neutrino& Neutrino::operator=(const Neutrino& other)
 {
-  std::cout<<"Neutrino copy assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Neutrino copy assignment operator called.");
   if(this != &other)
   {
     // Copy the neutrino properties
@@ -76,7 +77,7 @@ Neutrino& Neutrino::operator=(const Neutrino& other)
 
 Neutrino& Neutrino::operator=(Neutrino&& other) noexcept
 {
-  std::cout<<"Neutrino move assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Neutrino move assignment operator called.");
   if(this != &other)
   {
     // Move the neutrino properties
@@ -116,10 +117,3 @@ void Neutrino::print() const
   std::cout<<"ID: "<<particle_id<<std::endl;
   std::cout<<"Charge (e): "<<particle_charge<<std::endl;
 }
-
-// Detection method
-bool Neutrino::can_be_detected_by(const std::string& detector_type) const
-{
-  // Neutrinos are not detected by any of the detectors
-  return false;
-}
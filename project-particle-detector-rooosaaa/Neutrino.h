@@ -12,7 +12,8 @@
 // - Specific initialisation for neutrino charge (0) and particle name ("Neutrino")
 // - Rule of 5 implementation for proper memory management (constructors, assignment operators, and destructor)
 // - A `print` method to display particle information
-// - A `can_be_detected_by` method to check if the neutrino can be detected by a given detector type
+// - A `get_type` method returning the neutrino type code, which determines the sub-detectors that can
+//   detect it (see DetectionCapability.h)
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -46,16 +47,15 @@ namespace ParticleSystem
     // Destructor
     ~Neutrino();
 
+    // [GETTERS]
+    ParticleType get_type() const override {return ParticleType::Neutrino;}
+
     // [SETTERS]
     void set_name(std::string name) override;
     void set_charge(double charge) override;
     
     // [PRINT METHOD]
     void print() const override;
-    
-    // [DETECTION METHOD]
-    // Method to check if particle can be detected by a detector type
-    bool can_be_detected_by(const std::string& detectorType) const override;
   };
 } // namespace ParticleSystem
 
@@ -18,6 +18,7 @@
 #include<climits>  // For INT_MAX
 
 #include "Particle.h"
+#include "DetectionCapability.h"
 
 using namespace ParticleSystem;
 
@@ -80,3 +81,13 @@ void Particle::set_momentum(const FourMomentum& momentum)
     + particle_name);}
   else {particle_four_momentum = momentum;}
 }
+
+// [PHYSICS METHODS]
+
+bool Particle::can_be_detected_by(const std::string& detector_type) const
+{
+  // Unknown sub-detector names cannot detect anything
+  DetectorSubsystems::SubDetectorType sub_detector_type;
+  if(!DetectorSubsystems::find_sub_detector_type(detector_type, sub_detector_type)) {return false;}
+  return DetectorSubsystems::can_be_detected(get_type(), sub_detector_type);
+}
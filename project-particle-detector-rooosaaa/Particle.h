@@ -12,7 +12,7 @@
 // - Particle identification using name, ID, and charge
 // - Encapsulation of four-momentum using a separate `FourMomentum` class
 // - Validation of particle properties (name, charge, ID)
-// - Polymorphic interface for particle-specific detection and printing logic
+// - Polymorphic interface for particle-specific type codes and printing logic
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -25,6 +25,7 @@
 #include<memory>
 
 #include "FourMomentum.h"
+#include "ParticleType.h"
 
 using namespace ParticleProperties;
 
@@ -64,6 +65,8 @@ namespace ParticleSystem
     const FourMomentum& get_momentum() const {return particle_four_momentum;}
     int get_id() const {return particle_id;}
     double get_charge() const {return particle_charge;}
+    // Pure virtual method returning the compact type code of the concrete particle class
+    virtual ParticleType get_type() const = 0;
 
     // [SETTERS]
     // Set the particle four momentum
@@ -76,8 +79,9 @@ namespace ParticleSystem
     // Virtual methods that must be implemented by derived classes
     // Pure virtual print method to display particle information
     virtual void print() const = 0;
-    // Pure virtual method to check if particle can be detected by a detector type
-    virtual bool can_be_detected_by(const std::string& detector_type) const = 0;
+    // Virtual method to check if particle can be detected by a detector type (given by name).
+    // By default this looks up the particle's type in the detectability table.
+    virtual bool can_be_detected_by(const std::string& detector_type) const;
   };
 } // namespace ParticleSystem
 
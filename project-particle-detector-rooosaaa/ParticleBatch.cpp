@@ -0,0 +1,77 @@
+// ParticleBatch.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the ParticleBatch structure-of-arrays buffer. It provides
+// helpers for filling the particle columns, either from raw momentum components or from
+// existing Particle objects, and for recording event boundaries.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<stdexcept>
+
+#include "ParticleBatch.h"
+
+using namespace ParticleSystem;
+
+// [METHODS]
+
+void ParticleBatch::reserve(std::size_t events, std::size_t particles)
+{
+  px.reserve(particles);
+  py.reserve(particles);
+  pz.reserve(particles);
+  energy.reserve(particles);
+  charge.reserve(particles);
+  type.reserve(particles);
+  event_offsets.reserve(events + 1);
+}
+
+void ParticleBatch::clear()
+{
+  px.clear();
+  py.clear();
+  pz.clear();
+  energy.clear();
+  charge.clear();
+  type.clear();
+  // Keep the leading zero offset so the batch is always in a valid state
+  event_offsets.assign(1, 0);
+}
+
+void ParticleBatch::add_particle(ParticleType particle_type, double particle_charge, double momentum_x,
+  double momentum_y, double momentum_z, double particle_energy)
+{
+  // Apply the same physical constraints as the FourMomentum class
+  if(!FourMomentum::validate_components(momentum_x, momentum_y, momentum_z, particle_energy))
+  {
+    throw std::invalid_argument(
+      "Invalid four-momentum components for batch particle. Energy must be non-negative and E^2 >= p^2.");
+  }
+  px.push_back(momentum_x);
+  py.push_back(momentum_y);
+  pz.push_back(momentum_z);
+  energy.push_back(particle_energy);
+  charge.push_back(particle_charge);
+  type.push_back(particle_type);
+}
+
+void ParticleBatch::add_particle(const Particle& particle)
+{
+  // The Particle object has already validated its four-momentum, so the columns are filled directly
+  const auto& momentum = particle.get_momentum();
+  px.push_back(momentum.get_px());
+  py.push_back(momentum.get_py());
+  pz.push_back(momentum.get_pz());
+  energy.push_back(momentum.get_energy());
+  charge.push_back(particle.get_charge());
+  type.push_back(particle.get_type());
+}
+
+void ParticleBatch::end_event()
+{
+  event_offsets.push_back(number_of_particles());
+}
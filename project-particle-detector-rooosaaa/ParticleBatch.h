@@ -0,0 +1,76 @@
+// ParticleBatch.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `ParticleBatch` structure, a structure-of-arrays (SoA) buffer
+// that stores many events worth of particles as contiguous columns (px, py, pz, E, charge and
+// particle type code) instead of individually allocated `Particle` objects.
+//
+// The batch is the input of `Detector::process_batch`, which processes every particle in a
+// single pass without virtual dispatch, per-particle heap allocation or console output.
+// Event boundaries are stored as offsets into the particle columns so that event-level
+// quantities can still be computed after detection.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PARTICLE_BATCH_H
+#define PARTICLE_BATCH_H
+
+#include<cstddef>
+#include<cstdint>
+#include<vector>
+
+#include "Particle.h"
+#include "ParticleBatchView.h"
+#include "ParticleType.h"
+
+namespace ParticleSystem
+{
+  struct ParticleBatch
+  {
+    // [COLUMNS]
+    // One entry per particle, all columns have the same length
+    std::vector<double> px; // x-component of momentum in GeV
+    std::vector<double> py; // y-component of momentum in GeV
+    std::vector<double> pz; // z-component of momentum in GeV
+    std::vector<double> energy; // energy (E) in GeV
+    std::vector<double> charge; // charge in units of elementary charge (e)
+    std::vector<ParticleType> type; // particle type code
+    // Event boundaries: event i owns particles [event_offsets[i], event_offsets[i + 1])
+    // The first entry is always 0, so there are number_of_events() + 1 entries.
+    std::vector<std::uint64_t> event_offsets{0};
+    // Global number of the first event in this batch. Smearing draws are keyed by the global
+    // event number, so a run split into several batches (or files) gives the same readings
+    // as a single batch.
+    std::uint64_t first_event_number = 0;
+
+    // [METHODS]
+    // Reserve space for a number of events and particles to avoid reallocation while filling
+    void reserve(std::size_t events, std::size_t particles);
+    // Remove all particles and events (first_event_number is left unchanged)
+    void clear();
+    // Append a particle from its raw components to the current event (validates the momentum)
+    void add_particle(ParticleType particle_type, double particle_charge, double momentum_x,
+      double momentum_y, double momentum_z, double particle_energy);
+    // Append a copy of an existing Particle object to the current event
+    void add_particle(const Particle& particle);
+    // Close the current event; all particles added since the last call belong to it
+    void end_event();
+
+    // Return a non-owning view of the closed events (invalidated when the batch is modified)
+    ParticleBatchView view() const
+    {
+      return ParticleBatchView{px.data(), py.data(), pz.data(), energy.data(), charge.data(), type.data(),
+        event_offsets.data(), number_of_events(), first_event_number};
+    }
+
+    // [GETTERS]
+    std::size_t number_of_particles() const {return energy.size();}
+    std::size_t number_of_events() const {return event_offsets.size() - 1;}
+  };
+} // namespace ParticleSystem
+
+#endif // PARTICLE_BATCH_H
@@ -0,0 +1,52 @@
+// ParticleBatchView.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `ParticleBatchView` structure, a non-owning view of
+// structure-of-arrays particle columns. It has the same layout as `ParticleBatch` but only
+// holds pointers, so the columns can live in a ParticleBatch, a memory-mapped event file or
+// any other contiguous storage. `Detector::process_batch` reads its input through a view.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PARTICLE_BATCH_VIEW_H
+#define PARTICLE_BATCH_VIEW_H
+
+#include<cstddef>
+#include<cstdint>
+
+#include "ParticleType.h"
+
+namespace ParticleSystem
+{
+  struct ParticleBatchView
+  {
+    // [COLUMNS]
+    // One entry per particle, see ParticleBatch for the meaning and units of each column
+    const double* px = nullptr;
+    const double* py = nullptr;
+    const double* pz = nullptr;
+    const double* energy = nullptr;
+    const double* charge = nullptr;
+    const ParticleType* type = nullptr;
+    // Event boundaries, events + 1 entries starting at 0:
+    // event i owns particles [event_offsets[i], event_offsets[i + 1])
+    const std::uint64_t* event_offsets = nullptr;
+    // Number of events in the view
+    std::size_t events = 0;
+    // Global number of the first event in the view (keys the smearing draws)
+    std::uint64_t first_event_number = 0;
+
+    // [GETTERS]
+    std::size_t number_of_events() const {return events;}
+    std::size_t number_of_particles() const
+    {
+      return event_offsets == nullptr ? 0 : static_cast<std::size_t>(event_offsets[events]);
+    }
+  };
+} // namespace ParticleSystem
+
+#endif // PARTICLE_BATCH_VIEW_H
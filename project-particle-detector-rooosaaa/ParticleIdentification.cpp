@@ -0,0 +1,137 @@
+// ParticleIdentification.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the batch particle identification kernel. The vector code paths
+// handle 16 particles per iteration: each sub-detector column is compared against zero to
+// give a 16-bit mask, the masks are spread into one signature byte per particle, and a
+// byte shuffle looks all 16 signatures up in the identification table at once.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<cstring>
+
+#include "ParticleIdentification.h"
+#include "SimdSupport.h"
+
+#if PARTICLE_DETECTOR_X86_SIMD
+#include<immintrin.h>
+#endif
+
+namespace ParticleDetector
+{
+  namespace
+  {
+    using EnergyColumns = std::array<const double*, DetectorSubsystems::number_of_sub_detector_types>;
+
+    // The vector paths store one identification code per byte
+    static_assert(sizeof(IdentifiedParticle) == 1, "IdentifiedParticle must be one byte");
+
+    // Reference implementation, also used for the tails of the vector loops
+    void identify_particles_scalar(const EnergyColumns& energy_columns, IdentifiedParticle* identified,
+      std::size_t first, std::size_t count)
+    {
+      for(std::size_t i = first; i < count; ++i)
+      {
+        unsigned int signature = 0;
+        for(std::size_t type = 0; type < energy_columns.size(); ++type)
+        {
+          signature |= static_cast<unsigned int>(energy_columns[type][i] > 0.0) << type;
+        }
+        identified[i] = identify_signature(static_cast<std::uint8_t>(signature));
+      }
+    }
+
+#if PARTICLE_DETECTOR_X86_SIMD
+    // Turn one 16-bit "detected" mask per sub-detector into 16 identification codes
+    __attribute__((target("avx2")))
+    void identify_from_masks(const std::array<unsigned int, DetectorSubsystems::number_of_sub_detector_types>& masks,
+      IdentifiedParticle* identified)
+    {
+      // Byte k of the spread mask selects bit (k % 8) of byte (k / 8) of the 16-bit mask
+      const __m128i byte_select = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1);
+      const __m128i bit_select = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+      const __m128i one = _mm_set1_epi8(1);
+      __m128i table;
+      std::memcpy(&table, identification_table.data(), sizeof(table));
+      __m128i signatures = _mm_setzero_si128();
+      for(std::size_t type = 0; type < masks.size(); ++type)
+      {
+        __m128i bits = _mm_shuffle_epi8(_mm_set1_epi16(static_cast<short>(masks[type])), byte_select);
+        // 0 or 1 per particle, then moved to this sub-detector's bit (values stay within a byte)
+        bits = _mm_min_epu8(_mm_and_si128(bits, bit_select), one);
+        signatures = _mm_or_si128(signatures, _mm_slli_epi16(bits, static_cast<int>(type)));
+      }
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(identified), _mm_shuffle_epi8(table, signatures));
+    }
+
+    // Four readings per compare, four compares per column and iteration
+    __attribute__((target("avx2")))
+    void identify_particles_avx2(const EnergyColumns& energy_columns, IdentifiedParticle* identified,
+      std::size_t count)
+    {
+      const __m256d zero = _mm256_setzero_pd();
+      std::array<unsigned int, DetectorSubsystems::number_of_sub_detector_types> masks;
+      std::size_t i = 0;
+      for(; i + 16 <= count; i += 16)
+      {
+        for(std::size_t type = 0; type < energy_columns.size(); ++type)
+        {
+          unsigned int mask = 0;
+          for(std::size_t quarter = 0; quarter < 4; ++quarter)
+          {
+            const __m256d energies = _mm256_loadu_pd(energy_columns[type] + i + 4 * quarter);
+            mask |= static_cast<unsigned int>(_mm256_movemask_pd(_mm256_cmp_pd(energies, zero, _CMP_GT_OQ)))
+              << (4 * quarter);
+          }
+          masks[type] = mask;
+        }
+        identify_from_masks(masks, identified + i);
+      }
+      identify_particles_scalar(energy_columns, identified, i, count);
+    }
+
+    // Eight readings per compare, two compares per column and iteration
+    __attribute__((target("avx512f")))
+    void identify_particles_avx512(const EnergyColumns& energy_columns, IdentifiedParticle* identified,
+      std::size_t count)
+    {
+      const __m512d zero = _mm512_setzero_pd();
+      std::array<unsigned int, DetectorSubsystems::number_of_sub_detector_types> masks;
+      std::size_t i = 0;
+      for(; i + 16 <= count; i += 16)
+      {
+        for(std::size_t type = 0; type < energy_columns.size(); ++type)
+        {
+          const __mmask8 low = _mm512_cmp_pd_mask(_mm512_loadu_pd(energy_columns[type] + i), zero, _CMP_GT_OQ);
+          const __mmask8 high = _mm512_cmp_pd_mask(_mm512_loadu_pd(energy_columns[type] + i + 8), zero, _CMP_GT_OQ);
+          masks[type] = static_cast<unsigned int>(low) | (static_cast<unsigned int>(high) << 8);
+        }
+        identify_from_masks(masks, identified + i);
+      }
+      identify_particles_scalar(energy_columns, identified, i, count);
+    }
+#endif
+  }
+
+  void identify_particles(const EnergyColumns& energy_columns, IdentifiedParticle* identified, std::size_t count)
+  {
+#if PARTICLE_DETECTOR_X86_SIMD
+    switch(DetectorSimd::active_simd_level())
+    {
+      case DetectorSimd::SimdLevel::AVX512:
+        identify_particles_avx512(energy_columns, identified, count);
+        return;
+      case DetectorSimd::SimdLevel::AVX2:
+        identify_particles_avx2(energy_columns, identified, count);
+        return;
+      case DetectorSimd::SimdLevel::Scalar:
+        break;
+    }
+#endif
+    identify_particles_scalar(energy_columns, identified, 0, count);
+  }
+} // namespace ParticleDetector
@@ -0,0 +1,122 @@
+// ParticleIdentification.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `IdentifiedParticle` enumeration and the table-driven
+// particle identification used by the detector. A particle's detection signature is a
+// 4-bit mask with one bit per sub-detector that recorded energy (same bit layout as
+// DetectionCapability.h), and identification is a single lookup in a 16-entry table:
+//
+//   Signature (Muon|Hadronic|EM|Tracker) | Identified as
+//   0000                                 | Nothing Detected (Possible Neutrino)
+//   0010                                 | Photon
+//   0011                                 | Electron or Positron
+//   0101                                 | Hadron
+//   1001                                 | Muon
+//   any other pattern                    | Unknown
+//
+// Identification results are kept as enum codes; the display names are only produced when
+// results are printed. `identify_particles` classifies whole readings columns at once, with
+// AVX-512 and AVX2 code paths selected at run time (see SimdSupport.h).
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PARTICLE_IDENTIFICATION_H
+#define PARTICLE_IDENTIFICATION_H
+
+#include<array>
+#include<cstddef>
+#include<cstdint>
+
+#include "DetectionCapability.h"
+#include "DetectorReadings.h"
+#include "SubDetectorType.h"
+
+namespace ParticleDetector
+{
+  // Result of identifying a particle from its detector readings
+  enum class IdentifiedParticle : std::uint8_t
+  {
+    Unknown = 0,
+    Photon = 1,
+    ElectronOrPositron = 2,
+    Hadron = 3,
+    Muon = 4,
+    NothingDetected = 5
+  };
+
+  // Number of distinct identification results, useful for sizing counters
+  constexpr std::size_t number_of_identification_results = 6;
+
+  // Number of distinct detection signatures (one bit per sub-detector)
+  constexpr std::size_t number_of_signatures = 1u << DetectorSubsystems::number_of_sub_detector_types;
+
+  // Build the identification table from the known interaction signatures
+  constexpr std::array<IdentifiedParticle, number_of_signatures> make_identification_table()
+  {
+    using DetectorSubsystems::SubDetectorType;
+    using DetectorSubsystems::sub_detector_bit;
+    std::array<IdentifiedParticle, number_of_signatures> table{};
+    table[0] = IdentifiedParticle::NothingDetected;
+    table[sub_detector_bit(SubDetectorType::EMCalorimeter)] = IdentifiedParticle::Photon;
+    table[sub_detector_bit(SubDetectorType::Tracker) | sub_detector_bit(SubDetectorType::EMCalorimeter)] =
+      IdentifiedParticle::ElectronOrPositron;
+    table[sub_detector_bit(SubDetectorType::Tracker) | sub_detector_bit(SubDetectorType::HadronicCalorimeter)] =
+      IdentifiedParticle::Hadron;
+    table[sub_detector_bit(SubDetectorType::Tracker) | sub_detector_bit(SubDetectorType::MuonSpectrometer)] =
+      IdentifiedParticle::Muon;
+    return table;
+  }
+
+  // Identification of every 4-bit detection signature
+  constexpr std::array<IdentifiedParticle, number_of_signatures> identification_table = make_identification_table();
+
+  // Identify a particle from its detection signature (only the low 4 bits are used)
+  constexpr IdentifiedParticle identify_signature(std::uint8_t signature)
+  {
+    return identification_table[signature & (number_of_signatures - 1)];
+  }
+
+  // Detection signature of a set of readings (energy > 0 means the particle interacted
+  // with that sub-detector); built without branches
+  inline std::uint8_t detection_signature(const DetectorReadings& readings)
+  {
+    unsigned int signature = 0;
+    for(std::size_t type = 0; type < readings.energies.size(); ++type)
+    {
+      signature |= static_cast<unsigned int>(readings.energies[type] > 0.0) << type;
+    }
+    return static_cast<std::uint8_t>(signature);
+  }
+
+  // Return the display name of an identification result
+  inline const char* identified_particle_name(IdentifiedParticle identified)
+  {
+    switch(identified)
+    {
+      case IdentifiedParticle::Photon: return "Photon";
+      case IdentifiedParticle::ElectronOrPositron: return "Electron or Positron";
+      case IdentifiedParticle::Hadron: return "Hadron";
+      case IdentifiedParticle::Muon: return "Muon";
+      case IdentifiedParticle::NothingDetected: return "Nothing Detected (Possible Neutrino)";
+      case IdentifiedParticle::Unknown: break;
+    }
+    return "Unknown";
+  }
+
+  // Identify `count` particles from one readings column per sub-detector (indexed by
+  // SubDetectorType) and write one result per particle
+  void identify_particles(
+    const std::array<const double*, DetectorSubsystems::number_of_sub_detector_types>& energy_columns,
+    IdentifiedParticle* identified, std::size_t count);
+
+  static_assert(identify_signature(0b0011) == IdentifiedParticle::ElectronOrPositron,
+    "Tracker + EM Calorimeter must identify an electron or positron");
+  static_assert(identify_signature(0b1111) == IdentifiedParticle::Unknown,
+    "Unlisted signatures must identify as unknown");
+} // namespace ParticleDetector
+
+#endif // PARTICLE_IDENTIFICATION_H
@@ -0,0 +1,169 @@
+// ParticlePool.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `ParticlePool` class template, a slab allocator for one
+// particle class, and `ParticlePools`, which holds one pool per concrete particle class.
+//
+// A pool allocates slots for its particle class in slabs of many slots at a time. Making a
+// particle constructs it in place in a free slot; when its `ParticlePtr` is destroyed the
+// particle is destroyed and its slot goes back on the pool's free list, ready to be reused
+// by the next particle. Once the pool has grown to the largest number of particles alive at
+// any one time, generating events makes no calls to the global allocator for particles.
+// (Particle names are short enough to be stored inside std::string itself, so they do not
+// allocate either.)
+//
+// A pool is not thread-safe: use one set of pools per thread. Every particle made by a
+// pool must be released before the pool is destroyed.
+//
+// Example:
+//   ParticlePools pools;
+//   ParticlePtr photon = pools.make_particle<Photon>(1, FourMomentum(30.0, 25.0, 0.0, 60.0));
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PARTICLE_POOL_H
+#define PARTICLE_POOL_H
+
+#include<cstddef>
+#include<memory>
+#include<new>
+#include<tuple>
+#include<type_traits>
+#include<utility>
+#include<vector>
+
+#include "Particle.h"
+#include "ParticlePtr.h"
+#include "Electron.h"
+#include "Positron.h"
+#include "Muon.h"
+#include "Photon.h"
+#include "Neutrino.h"
+#include "Hadron.h"
+
+namespace ParticleSystem
+{
+  template<typename T>
+  class ParticlePool : public ParticleStorage
+  {
+    static_assert(std::is_base_of_v<Particle, T>, "A ParticlePool can only hold particles");
+
+  private:
+    // A slot holds either a live particle or the link to the next free slot
+    union Slot
+    {
+      Slot* next_free;
+      alignas(T) std::byte storage[sizeof(T)];
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs;
+    Slot* free_list; // singly linked list of the free slots
+    std::size_t slab_size; // number of slots per slab
+    std::size_t particles_in_use;
+
+    // Allocate a new slab and put all of its slots on the free list
+    void add_slab()
+    {
+      slabs.push_back(std::unique_ptr<Slot[]>(new Slot[slab_size]));
+      Slot* slab = slabs.back().get();
+      for(std::size_t i = slab_size; i > 0; --i)
+      {
+        slab[i - 1].next_free = free_list;
+        free_list = &slab[i - 1];
+      }
+    }
+
+  public:
+    // Default number of slots per slab
+    static constexpr std::size_t default_slab_size = 256;
+
+    // [RULE OF 5]
+    // Parameterised constructor: slabs are only allocated once particles are made
+    explicit ParticlePool(std::size_t slots_per_slab = default_slab_size) :
+      free_list{nullptr}, slab_size{slots_per_slab == 0 ? default_slab_size : slots_per_slab},
+      particles_in_use{0} {}
+    // Not allowing copy or move operations as the particles made by the pool point to it
+    // Copy constructor
+    ParticlePool(const ParticlePool& other) = delete;
+    // Move constructor
+    ParticlePool(ParticlePool&& other) = delete;
+    // Copy assignment operator
+    ParticlePool& operator=(const ParticlePool& other) = delete;
+    // Move assignment operator
+    ParticlePool& operator=(ParticlePool&& other) = delete;
+    // Destructor
+    ~ParticlePool() = default;
+
+    // [GETTERS]
+    std::size_t number_in_use() const {return particles_in_use;}
+    std::size_t capacity() const {return slabs.size() * slab_size;}
+
+    // [METHODS]
+    // Make sure at least `count` particles can be alive at once without growing the pool
+    void reserve(std::size_t count)
+    {
+      while(capacity() < count) {add_slab();}
+    }
+    // Construct a particle in a free slot (the pool grows by one slab if none is free)
+    template<typename... Args> ParticlePtr make_particle(Args&&... args)
+    {
+      if(free_list == nullptr) {add_slab();}
+      Slot* slot = free_list;
+      free_list = slot->next_free;
+      try
+      {
+        T* particle = new(slot->storage) T(std::forward<Args>(args)...);
+        ++particles_in_use;
+        return ParticlePtr(particle, ParticleDeleter{this});
+      }
+      catch(...)
+      {
+        // Invalid constructor arguments: put the slot back before passing on the error
+        slot->next_free = free_list;
+        free_list = slot;
+        throw;
+      }
+    }
+    // Destroy a particle made by this pool and put its slot back on the free list
+    void release(Particle* particle) override
+    {
+      T* typed_particle = static_cast<T*>(particle);
+      typed_particle->~T();
+      Slot* slot = reinterpret_cast<Slot*>(typed_particle); // the particle starts its slot
+      slot->next_free = free_list;
+      free_list = slot;
+      --particles_in_use;
+    }
+  };
+
+  // One pool per concrete particle class
+  class ParticlePools
+  {
+  private:
+    std::tuple<ParticlePool<Electron>, ParticlePool<Positron>, ParticlePool<Muon>,
+      ParticlePool<Photon>, ParticlePool<Neutrino>, ParticlePool<Hadron>> pools;
+
+  public:
+    // [GETTERS]
+    // Pool of one particle class, e.g. get_pool<Photon>()
+    template<typename T> ParticlePool<T>& get_pool() {return std::get<ParticlePool<T>>(pools);}
+    // Total number of particles currently made by the pools
+    std::size_t number_in_use() const
+    {
+      return std::apply([](const auto&... pool) {return (pool.number_in_use() + ...);}, pools);
+    }
+
+    // [METHODS]
+    // Construct a particle of class T in its pool
+    template<typename T, typename... Args> ParticlePtr make_particle(Args&&... args)
+    {
+      return get_pool<T>().make_particle(std::forward<Args>(args)...);
+    }
+  };
+} // namespace ParticleSystem
+
+#endif // PARTICLE_POOL_H
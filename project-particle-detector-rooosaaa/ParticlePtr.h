@@ -0,0 +1,56 @@
+// ParticlePtr.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the owning pointer used for particles that may live outside the
+// general heap. A `ParticlePtr` is a std::unique_ptr whose `ParticleDeleter` hands the
+// particle back to the `ParticleStorage` it came from (an EventArena or a ParticlePool), or
+// deletes it if it was created with `new`. The `ParticleList` of an event holds these
+// pointers in a std::pmr::vector, so the list itself can also use an arena's memory.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PARTICLE_PTR_H
+#define PARTICLE_PTR_H
+
+#include<memory>
+#include<memory_resource>
+#include<vector>
+
+#include "Particle.h"
+
+namespace ParticleSystem
+{
+  // Interface of the storage that particles can be created in and returned to
+  class ParticleStorage
+  {
+  public:
+    // Destroy a particle created by this storage and take back its memory
+    virtual void release(Particle* particle) = 0;
+
+  protected:
+    ~ParticleStorage() = default;
+  };
+
+  // Deleter for particles that are either on the heap (no storage) or in a ParticleStorage
+  struct ParticleDeleter
+  {
+    ParticleStorage* storage{nullptr};
+
+    void operator()(Particle* particle) const
+    {
+      if(storage != nullptr) {storage->release(particle);}
+      else {delete particle;}
+    }
+  };
+
+  // Owning pointer to a particle (heap, arena or pool)
+  using ParticlePtr = std::unique_ptr<Particle, ParticleDeleter>;
+  // List of the particles of an event, allocated from a memory resource such as an EventArena
+  using ParticleList = std::pmr::vector<ParticlePtr>;
+} // namespace ParticleSystem
+
+#endif // PARTICLE_PTR_H
@@ -0,0 +1,53 @@
+// ParticleType.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `ParticleType` enumeration, a compact integer code for each
+// concrete particle class in the simulation. The code is used wherever particles are stored
+// without their polymorphic objects, e.g. the structure-of-arrays buffers in ParticleBatch.h,
+// so that a whole column of particles can be processed without virtual dispatch.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PARTICLE_TYPE_H
+#define PARTICLE_TYPE_H
+
+#include<cstddef>
+#include<cstdint>
+
+namespace ParticleSystem
+{
+  // One code per concrete Particle subclass (fits in a single byte per particle)
+  enum class ParticleType : std::uint8_t
+  {
+    Electron = 0,
+    Positron = 1,
+    Muon = 2,
+    Photon = 3,
+    Hadron = 4,
+    Neutrino = 5
+  };
+
+  // Number of distinct particle types, useful for sizing lookup tables
+  constexpr std::size_t number_of_particle_types = 6;
+
+  // Return the display name of a particle type
+  inline const char* particle_type_name(ParticleType type)
+  {
+    switch(type)
+    {
+      case ParticleType::Electron: return "Electron";
+      case ParticleType::Positron: return "Positron";
+      case ParticleType::Muon: return "Muon";
+      case ParticleType::Photon: return "Photon";
+      case ParticleType::Hadron: return "Hadron";
+      case ParticleType::Neutrino: return "Neutrino";
+    }
+    return "Unknown";
+  }
+} // namespace ParticleSystem
+
+#endif // PARTICLE_TYPE_H
@@ -0,0 +1,85 @@
+// PdgMapping.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file maps Particle Data Group (PDG) Monte Carlo particle numbers, as used in
+// generator event files, onto the particle types of this project:
+//
+//   11 / -11                      -> Electron / Positron
+//   13, -13                       -> Muon (charge -1 / +1)
+//   22                            -> Photon
+//   12, 14, 16 and antiparticles  -> Neutrino
+//   quarks 1-6, gluon 21          -> Hadron (they hadronise into jets)
+//   mesons and baryons            -> Hadron, with the charge of their quark content
+//
+// Every other code (tau leptons, gauge and Higgs bosons, nuclei, exotic states) has no
+// equivalent particle class and is reported as not mapped.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PDG_MAPPING_H
+#define PDG_MAPPING_H
+
+#include "ParticleType.h"
+
+namespace ParticleSystem
+{
+  // Charge of a quark flavour (1 = d ... 6 = t) in units of e/3, so sums stay exact
+  constexpr int quark_three_charge(int flavour)
+  {
+    return flavour % 2 == 0 ? 2 : -1;
+  }
+
+  // Find the particle type and charge for a PDG particle number; returns false if the
+  // particle has no equivalent type in this project
+  constexpr bool particle_type_from_pdg_id(int pdg_id, ParticleType& type, double& charge)
+  {
+    const int sign = pdg_id < 0 ? -1 : 1;
+    const int code = pdg_id * sign;
+    switch(code)
+    {
+      case 11: type = pdg_id > 0 ? ParticleType::Electron : ParticleType::Positron; charge = -sign; return true;
+      case 13: type = ParticleType::Muon; charge = -sign; return true;
+      case 22: type = ParticleType::Photon; charge = 0.0; return true;
+      case 12: case 14: case 16: type = ParticleType::Neutrino; charge = 0.0; return true;
+      case 21: type = ParticleType::Hadron; charge = 0.0; return true;
+      default: break;
+    }
+    if(code >= 1 && code <= 6)
+    {
+      type = ParticleType::Hadron;
+      charge = sign * quark_three_charge(code) / 3.0;
+      return true;
+    }
+    // Hadron numbers: ...n_q1 n_q2 n_q3 n_J, with n_q1 = 0 for mesons. Larger numbers
+    // (nuclei and excited or exotic states) are not mapped.
+    if(code < 100 || code >= 10000) {return false;}
+    const int quark_1 = (code / 1000) % 10;
+    const int quark_2 = (code / 100) % 10;
+    const int quark_3 = (code / 10) % 10;
+    if(quark_2 == 0 || quark_3 == 0 || quark_2 > 6 || quark_3 > 6) {return false;}
+    type = ParticleType::Hadron;
+    if(quark_1 != 0)
+    {
+      // Baryon made of three quarks
+      charge = sign * (quark_three_charge(quark_1) + quark_three_charge(quark_2) +
+        quark_three_charge(quark_3)) / 3.0;
+    }
+    else if(quark_2 % 2 == 0)
+    {
+      // Meson whose heavier quark is up-type: quark_2 is the quark, quark_3 the antiquark
+      charge = sign * (quark_three_charge(quark_2) - quark_three_charge(quark_3)) / 3.0;
+    }
+    else
+    {
+      // Meson whose heavier quark is down-type: quark_2 is the antiquark
+      charge = sign * (quark_three_charge(quark_3) - quark_three_charge(quark_2)) / 3.0;
+    }
+    return true;
+  }
+} // namespace ParticleSystem
+
+#endif // PDG_MAPPING_H
@@ -0,0 +1,279 @@
+// PhaseSpaceGenerator.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the PhaseSpaceGenerator class. Each event uses five Philox blocks,
+// keyed by (seed, event number, block index, generator stream); each block gives two uniform
+// draws. Daughter four-momenta are computed in the rest frame of their parent and boosted with
+// the parent's four-momentum (no velocity is formed, which keeps large boosts accurate), and
+// each daughter energy is finally recomputed from its momentum and mass so that it lies
+// exactly on its mass shell. The columns of the batch are written directly by index.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<cmath>
+#include<limits>
+#include<stdexcept>
+
+#include "PhaseSpaceGenerator.h"
+
+using namespace ParticleSystem;
+
+namespace
+{
+  // Masses and widths in GeV (Particle Data Group 2024)
+  constexpr double higgs_mass = 125.20;
+  constexpr double higgs_width = 0.0037;
+  constexpr double z_mass = 91.1876;
+  constexpr double z_width = 2.4955;
+  constexpr double top_mass = 172.57;
+  constexpr double top_width = 1.42;
+  constexpr double w_mass = 80.369;
+  constexpr double w_width = 2.085;
+  constexpr double bottom_mass = 4.18;
+  constexpr double electron_mass = 0.000510999;
+  constexpr double muon_mass = 0.105658;
+
+  constexpr double pi = 3.14159265358979323846;
+  // Largest number of daughters of any channel
+  constexpr std::size_t max_daughters = 3;
+  // Value of the sub-detector field of the random stream key; sub-detectors use 0 to 3, so
+  // the generator never reuses a smearing draw
+  constexpr std::uint32_t generator_stream = 0x50534700u;
+
+  struct Momentum
+  {
+    double px;
+    double py;
+    double pz;
+    double energy;
+  };
+
+  // The ten uniform draws of one event, in (0, 1]
+  std::array<double, 10> event_uniforms(std::uint64_t seed, std::uint64_t event_number)
+  {
+    std::array<double, 10> uniforms;
+    for(std::uint32_t block_index = 0; block_index < 5; ++block_index)
+    {
+      const auto block = DetectorRandom::random_block({seed, event_number, block_index, generator_stream});
+      uniforms[2 * block_index] = DetectorRandom::uniform_open_closed(block[0], block[1]);
+      uniforms[2 * block_index + 1] = DetectorRandom::uniform_open_closed(block[2], block[3]);
+    }
+    return uniforms;
+  }
+
+  // Breit-Wigner (Cauchy) mass restricted to [low, high], by inverting its cumulative distribution
+  double breit_wigner_mass(double mass, double width, double low, double high, double uniform)
+  {
+    const double first = std::atan(2.0 * (low - mass) / width);
+    const double last = std::atan(2.0 * (high - mass) / width);
+    return std::clamp(mass + 0.5 * width * std::tan(first + uniform * (last - first)), low, high);
+  }
+
+  // Momenta of the two daughters of a decay at rest, the first along the direction given by
+  // cos(theta) and phi; the second is back-to-back
+  void two_body_decay(double parent_mass, double mass_1, double mass_2, double cos_theta, double phi,
+    Momentum& daughter_1, Momentum& daughter_2)
+  {
+    const double sum = mass_1 + mass_2;
+    const double difference = mass_1 - mass_2;
+    const double momentum = std::sqrt(std::max(0.0, (parent_mass * parent_mass - sum * sum) *
+      (parent_mass * parent_mass - difference * difference))) / (2.0 * parent_mass);
+    const double sin_theta = std::sqrt(std::max(0.0, 1.0 - cos_theta * cos_theta));
+    const double px = momentum * sin_theta * std::cos(phi);
+    const double py = momentum * sin_theta * std::sin(phi);
+    const double pz = momentum * cos_theta;
+    daughter_1 = Momentum{px, py, pz, std::sqrt(momentum * momentum + mass_1 * mass_1)};
+    daughter_2 = Momentum{-px, -py, -pz, std::sqrt(momentum * momentum + mass_2 * mass_2)};
+  }
+
+  // Boost a momentum from the rest frame of a parent of the given mass into the frame in which
+  // the parent has the four-momentum `parent`
+  Momentum boost(const Momentum& momentum, const Momentum& parent, double parent_mass)
+  {
+    const double dot = momentum.px * parent.px + momentum.py * parent.py + momentum.pz * parent.pz;
+    const double factor = (dot / (parent.energy + parent_mass) + momentum.energy) / parent_mass;
+    return Momentum{momentum.px + factor * parent.px, momentum.py + factor * parent.py,
+      momentum.pz + factor * parent.pz, (momentum.energy * parent.energy + dot) / parent_mass};
+  }
+
+  // Energy of a particle of the given momentum and mass; rounding can leave E^2 just below
+  // p^2 for a massless particle, so E is then moved up to the next double above |p|
+  double on_shell_energy(const Momentum& momentum, double mass)
+  {
+    const double momentum_squared = momentum.px * momentum.px + momentum.py * momentum.py + momentum.pz * momentum.pz;
+    const double energy = std::sqrt(momentum_squared + mass * mass);
+    if(energy * energy >= momentum_squared) {return energy;}
+    return std::nextafter(std::sqrt(momentum_squared), std::numeric_limits<double>::infinity());
+  }
+}
+
+const char* ParticleSystem::decay_channel_name(DecayChannel channel)
+{
+  switch(channel)
+  {
+    case DecayChannel::HiggsToDiphoton: return "H -> gamma gamma";
+    case DecayChannel::ZToElectronPositron: return "Z -> e- e+";
+    case DecayChannel::AntiTopToBottomMuonNeutrino: return "anti-top -> anti-b mu- anti-nu";
+  }
+  return "Unknown";
+}
+
+// [CONSTRUCTORS]
+
+PhaseSpaceGenerator::PhaseSpaceGenerator(const PhaseSpaceOptions& generator_options) :
+  options{generator_options}, cumulative_weights{}
+{
+  double total = 0.0;
+  for(std::size_t channel = 0; channel < number_of_decay_channels; ++channel)
+  {
+    const double weight = options.channel_weights[channel];
+    if(!(weight >= 0.0) || !std::isfinite(weight)) {throw std::invalid_argument(
+      "Error: Decay channel weights must be finite and non-negative.");}
+    total += weight;
+    cumulative_weights[channel] = total;
+  }
+  if(!(total > 0.0)) {throw std::invalid_argument("Error: At least one decay channel weight must be positive.");}
+  for(auto& weight : cumulative_weights) {weight /= total;}
+  cumulative_weights.back() = 1.0;
+  if(!(options.max_transverse_momentum >= 0.0) || !std::isfinite(options.max_transverse_momentum) ||
+    !(options.max_rapidity >= 0.0) || !std::isfinite(options.max_rapidity))
+  {
+    throw std::invalid_argument("Error: Boost ranges must be finite and non-negative.");
+  }
+  if(!(options.width_cutoff > 0.0)) {throw std::invalid_argument("Error: Width cutoff must be positive.");}
+}
+
+// [GETTERS]
+
+DecayChannel PhaseSpaceGenerator::get_event_channel(std::uint64_t event_number) const
+{
+  const auto block = DetectorRandom::random_block({options.seed, event_number, 0, generator_stream});
+  const double uniform = DetectorRandom::uniform_open_closed(block[0], block[1]);
+  std::size_t channel = 0;
+  while(channel + 1 < number_of_decay_channels && uniform > cumulative_weights[channel]) {++channel;}
+  return static_cast<DecayChannel>(channel);
+}
+
+// [METHODS]
+
+// Function to append events to a batch:
+// - Grows the columns once for the largest possible number of particles, writes every event
+//   in place and then trims the columns to the particles actually written
+// - Event numbers continue from the events already in the batch
+void PhaseSpaceGenerator::generate(ParticleBatch& batch, std::size_t number_of_events) const
+{
+  if(batch.event_offsets.back() != batch.number_of_particles()) {throw std::logic_error(
+    "Error: Batch contains particles outside a closed event. Call end_event() before generating.");}
+  const std::uint64_t first_event_number = batch.first_event_number + batch.number_of_events();
+  std::size_t particle = batch.number_of_particles();
+  const std::size_t capacity = particle + max_daughters * number_of_events;
+  batch.px.resize(capacity);
+  batch.py.resize(capacity);
+  batch.pz.resize(capacity);
+  batch.energy.resize(capacity);
+  batch.charge.resize(capacity);
+  batch.type.resize(capacity);
+  batch.event_offsets.reserve(batch.event_offsets.size() + number_of_events);
+  for(std::size_t event = 0; event < number_of_events; ++event)
+  {
+    particle += generate_event(batch, particle, first_event_number + event);
+    batch.event_offsets.push_back(particle);
+  }
+  batch.px.resize(particle);
+  batch.py.resize(particle);
+  batch.pz.resize(particle);
+  batch.energy.resize(particle);
+  batch.charge.resize(particle);
+  batch.type.resize(particle);
+}
+
+// Function to generate the daughters of one event:
+// - Draws the channel, the resonance mass(es) and the boost of the decaying particle
+// - Decays it at rest (for the top quark, then decays the W boson at rest and boosts the W
+//   daughters into the top quark rest frame)
+// - Boosts every daughter into the lab frame and writes it to the batch
+std::size_t PhaseSpaceGenerator::generate_event(ParticleBatch& batch, std::size_t first_particle,
+  std::uint64_t event_number) const
+{
+  const auto uniforms = event_uniforms(options.seed, event_number);
+  std::size_t channel = 0;
+  while(channel + 1 < number_of_decay_channels && uniforms[0] > cumulative_weights[channel]) {++channel;}
+  const double cutoff = options.width_cutoff;
+  auto resonance_mass = [&](double mass, double width, double low, double high, double uniform)
+  {
+    if(!options.breit_wigner_masses) {return mass;}
+    return breit_wigner_mass(mass, width, std::max(low, mass - cutoff * width), std::min(high, mass + cutoff * width),
+      uniform);
+  };
+
+  std::array<Momentum, max_daughters> daughters;
+  std::array<double, max_daughters> masses;
+  std::array<double, max_daughters> charges;
+  std::array<ParticleType, max_daughters> types;
+  std::size_t number_of_daughters = 2;
+  double parent_mass = 0.0;
+  switch(static_cast<DecayChannel>(channel))
+  {
+    case DecayChannel::HiggsToDiphoton:
+      parent_mass = resonance_mass(higgs_mass, higgs_width, 0.0, 2.0 * higgs_mass, uniforms[4]);
+      masses = {0.0, 0.0, 0.0};
+      charges = {0.0, 0.0, 0.0};
+      types = {ParticleType::Photon, ParticleType::Photon, ParticleType::Photon};
+      two_body_decay(parent_mass, 0.0, 0.0, 2.0 * uniforms[6] - 1.0, 2.0 * pi * uniforms[7], daughters[0],
+        daughters[1]);
+      break;
+    case DecayChannel::ZToElectronPositron:
+      parent_mass = resonance_mass(z_mass, z_width, 2.0 * electron_mass, 2.0 * z_mass, uniforms[4]);
+      masses = {electron_mass, electron_mass, 0.0};
+      charges = {-1.0, 1.0, 0.0};
+      types = {ParticleType::Electron, ParticleType::Positron, ParticleType::Photon};
+      two_body_decay(parent_mass, electron_mass, electron_mass, 2.0 * uniforms[6] - 1.0, 2.0 * pi * uniforms[7],
+        daughters[0], daughters[1]);
+      break;
+    case DecayChannel::AntiTopToBottomMuonNeutrino:
+    {
+      number_of_daughters = 3;
+      // The W boson must be light enough for the top quark to decay into it and a b quark
+      parent_mass = resonance_mass(top_mass, top_width, bottom_mass + muon_mass + 1.0, 2.0 * top_mass, uniforms[4]);
+      const double w_boson_mass = resonance_mass(w_mass, w_width, muon_mass + 0.5, parent_mass - bottom_mass - 0.5,
+        uniforms[5]);
+      masses = {bottom_mass, muon_mass, 0.0};
+      charges = {1.0 / 3.0, -1.0, 0.0};
+      types = {ParticleType::Hadron, ParticleType::Muon, ParticleType::Neutrino};
+      Momentum w_boson;
+      two_body_decay(parent_mass, bottom_mass, w_boson_mass, 2.0 * uniforms[6] - 1.0, 2.0 * pi * uniforms[7],
+        daughters[0], w_boson);
+      two_body_decay(w_boson_mass, muon_mass, 0.0, 2.0 * uniforms[8] - 1.0, 2.0 * pi * uniforms[9],
+        daughters[1], daughters[2]);
+      daughters[1] = boost(daughters[1], w_boson, w_boson_mass);
+      daughters[2] = boost(daughters[2], w_boson, w_boson_mass);
+      break;
+    }
+  }
+
+  // Lab-frame four-momentum of the decaying particle
+  const double transverse_momentum = options.max_transverse_momentum * uniforms[1];
+  const double azimuth = 2.0 * pi * uniforms[2];
+  const double rapidity = options.max_rapidity * (2.0 * uniforms[3] - 1.0);
+  const double transverse_mass = std::sqrt(parent_mass * parent_mass + transverse_momentum * transverse_momentum);
+  const Momentum parent{transverse_momentum * std::cos(azimuth), transverse_momentum * std::sin(azimuth),
+    transverse_mass * std::sinh(rapidity), transverse_mass * std::cosh(rapidity)};
+
+  for(std::size_t daughter = 0; daughter < number_of_daughters; ++daughter)
+  {
+    const Momentum lab = boost(daughters[daughter], parent, parent_mass);
+    const std::size_t index = first_particle + daughter;
+    batch.px[index] = lab.px;
+    batch.py[index] = lab.py;
+    batch.pz[index] = lab.pz;
+    batch.energy[index] = on_shell_energy(lab, masses[daughter]);
+    batch.charge[index] = charges[daughter];
+    batch.type[index] = types[daughter];
+  }
+  return number_of_daughters;
+}
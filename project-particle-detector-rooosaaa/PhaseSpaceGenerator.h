@@ -0,0 +1,100 @@
+// PhaseSpaceGenerator.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Header file for the PhaseSpaceGenerator class, a Monte Carlo generator of resonance decays
+// with correct relativistic kinematics, written straight into the columns of a ParticleBatch:
+// - H → γγ (2-body)
+// - Z → e⁻ e⁺ (2-body)
+// - t̄ → b̄ W⁻ → b̄ μ⁻ ν̄_μ (3-body, as two sequential 2-body decays)
+//
+// For each event a channel is chosen according to the configured weights, the resonance
+// masses are drawn from truncated Breit-Wigner distributions (or fixed at the nominal masses),
+// and each 2-body decay is isotropic in the rest frame of the decaying particle (spin
+// correlations are not modelled). The decaying particle is then boosted into the lab frame
+// with a transverse momentum, azimuth and rapidity drawn uniformly from configurable ranges.
+// Every daughter is exactly on its mass shell and each event conserves four-momentum up to
+// rounding, so its invariant mass is the mass of the resonance.
+//
+// The random numbers of an event come from the counter-based Philox generator
+// (CounterRandom.h), keyed by the generator seed and the global event number. An event
+// therefore does not depend on which batch, thread or run generates it, and batches can be
+// generated concurrently by several threads through the same (const) generator.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef PHASE_SPACE_GENERATOR_H
+#define PHASE_SPACE_GENERATOR_H
+
+#include<array>
+#include<cstddef>
+#include<cstdint>
+
+#include "CounterRandom.h"
+#include "ParticleBatch.h"
+
+namespace ParticleSystem
+{
+  // Decays produced by the generator
+  enum class DecayChannel : std::uint8_t
+  {
+    HiggsToDiphoton = 0,
+    ZToElectronPositron = 1,
+    AntiTopToBottomMuonNeutrino = 2
+  };
+
+  // Number of distinct decay channels, useful for sizing per-channel arrays
+  constexpr std::size_t number_of_decay_channels = 3;
+
+  // Return the display name of a decay channel
+  const char* decay_channel_name(DecayChannel channel);
+
+  struct PhaseSpaceOptions
+  {
+    // Seed of the generated sample (independent of the detector's smearing draws)
+    std::uint64_t seed = DetectorRandom::default_run_seed;
+    // Relative rates of the channels, indexed by DecayChannel (need not add up to 1)
+    std::array<double, number_of_decay_channels> channel_weights{1.0, 1.0, 1.0};
+    // Boost of the decaying particle: transverse momentum in [0, max_transverse_momentum] GeV
+    // and rapidity in [-max_rapidity, max_rapidity], both uniform (0 and 0 = decays at rest)
+    double max_transverse_momentum = 50.0;
+    double max_rapidity = 2.5;
+    // Draw resonance masses from Breit-Wigner distributions cut at width_cutoff widths from
+    // the nominal mass, or use the nominal masses
+    bool breit_wigner_masses = true;
+    double width_cutoff = 5.0;
+  };
+
+  class PhaseSpaceGenerator
+  {
+  private:
+    PhaseSpaceOptions options;
+    // Cumulative channel weights, normalised so the last entry is 1
+    std::array<double, number_of_decay_channels> cumulative_weights;
+
+    // Write the daughters of one event from the given particle index onwards and return their number
+    std::size_t generate_event(ParticleBatch& batch, std::size_t first_particle, std::uint64_t event_number) const;
+
+  public:
+    // [CONSTRUCTORS]
+    // Parameterised constructor; throws if a weight is negative or not finite, if every
+    // weight is zero, or if a boost range or the width cutoff is invalid
+    explicit PhaseSpaceGenerator(const PhaseSpaceOptions& generator_options = PhaseSpaceOptions());
+
+    // [GETTERS]
+    const PhaseSpaceOptions& get_options() const {return options;}
+    // Channel of a given global event number
+    DecayChannel get_event_channel(std::uint64_t event_number) const;
+
+    // [METHODS]
+    // Append events to a batch. Their global event numbers follow on from the events already
+    // in the batch (starting at batch.first_event_number), so set first_event_number before
+    // generating into an empty batch. Safe to call concurrently on different batches.
+    void generate(ParticleBatch& batch, std::size_t number_of_events) const;
+  };
+} // namespace ParticleSystem
+
+#endif // PHASE_SPACE_GENERATOR_H
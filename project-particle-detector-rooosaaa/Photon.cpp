@@ -11,7 +11,7 @@
 // - The Rule of 5 methods for memory management.
 // - Setter methods for setting the name and charge of the photon (both properties are validated).
 // - The `print` method to display the photon's details, such as name, four-momentum, ID, and charge.
-// - The `can_be_detected_by` method, which checks whether the photon can be detected by a given detector type.
+// - Detection capability is defined by the particle type (see DetectionCapability.h)
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -20,6 +20,7 @@
 #include<iostream>
 
 #include "Photon.h"
+#include "Logging.h"
 
 using namespace ParticleSystem;
 
@@ -32,12 +33,12 @@ Photon::Photon(int id, const FourMomentum& momentum) : Particle("Photon", id, mo
 
 Photon::~Photon()
 {
-  std::cout<<"Photon destructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Photon destructor called.");
 }
 
 Photon::Photon(const Photon& other) : Particle(other)
 {
-  std::cout<<"Photon copy constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Photon copy constructor called.");
   // Copy the photon properties
   particle_name = other.particle_name;
   particle_four_momentum = other.particle_four_momentum;
@@ -47,7 +48,7 @@ Photon::Photon(const Photon& other) : Particle(other)
 
 Photon::Photon(Photon&& other) noexcept : Particle(std::move(other))
 {
-  std::cout<<"Photon move constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Photon move constructor called.");
   // Move the photon properties
   particle_name = std::move(other.particle_name);
   // Call move assignment operator for FourMomentum
@@ -61,7 +62,7 @@ Photon::Photon(Photon&& other) noexcept : Particle(std::move(other))
 
 Photon& Photon::operator=(const Photon& other)
 {
-  std::cout<<"Photon copy assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Photon copy assignment operator called.");
   if(this != &other)
   {
     // Copy the photon properties
@@ -75,7 +76,7 @@ Photon& Photon::operator=(const Photon& other)
 
 Photon& Photon::operator=(Photon&& other) noexcept
 {
-  std::cout<<"Photon move assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Photon move assignment operator called.");
   if(this != &other)
   {
     // Move the photon properties
@@ -114,11 +115,3 @@ void Photon::print() const
   std::cout<<"ID: "<<particle_id<<std::endl;
   std::cout<<"Charge (e): "<<particle_charge<<std::endl;
 }
-
-// Detection method
-bool Photon::can_be_detected_by(const std::string& detector_type) const
-{
-  // Photons are neutral and can only be detected by calorimeters
-  if(detector_type == "EM Calorimeter") {return true;}
-  else {return false;}
-}
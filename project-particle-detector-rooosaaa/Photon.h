@@ -11,7 +11,8 @@
 // - The Rule of 5 methods
 // - The setter methods to set the photon’s properties (name and charge)
 // - The `print` method that outputs the photon's properties
-// - The `can_be_detected_by` method which checks if the photon can be detected by a given detector
+// - The `get_type` method returning the photon type code, which determines the sub-detectors that can
+//   detect it (see DetectionCapability.h)
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -44,16 +45,15 @@ namespace ParticleSystem
     // Destructor
     ~Photon();
     
+    // [GETTERS]
+    ParticleType get_type() const override {return ParticleType::Photon;}
+
     // [SETTERS]
     void set_name(std::string name) override;
     void set_charge(double charge) override;
 
     // [PRINT METHOD]
     void print() const override;
-    
-    // [DETECTION METHOD]
-    // Method to check if particle can be detected by a detector type
-    bool can_be_detected_by(const std::string& detector_type) const override;
   };
 } // namespace ParticleSystem
 
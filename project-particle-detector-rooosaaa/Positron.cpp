@@ -11,7 +11,6 @@
 // - The Rule of 5 methods for memory management, ensuring proper copying and moving of positron objects.
 // - Setter methods for validating and setting the name and charge of the Positron.
 // - Print method for displaying information about the Positron.
-// - Detection method to check if the Positron can be detected by specific detector types.
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -20,6 +19,7 @@
 #include<iostream>
 
 #include "Positron.h"
+#include "Logging.h"
 
 using namespace ParticleSystem;
 
@@ -32,12 +32,12 @@ Positron::Positron(int id, const FourMomentum& momentum) : Particle("Positron",
 
 Positron::~Positron()
 {
-  std::cout<<"Positron destructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Positron destructor called.");
 }
 
 Positron::Positron(const Positron& other) : Particle(other)
 {
-  std::cout<<"Positron copy constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Positron copy constructor called.");
   // Copy the positron properties
   particle_name = other.particle_name;
   particle_four_momentum = other.particle_four_momentum;
@@ -47,7 +47,7 @@ Positron::Positron(const Positron& other) : Particle(other)
 
 Positron::Positron(Positron&& other) noexcept : Particle(std::move(other))
 {
-  std::cout<<"Positron move constructor called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Positron move constructor called.");
   // Move the electron properties
   particle_name = std::move(other.particle_name);
   // Call move assignment operator for FourMomentum
@@ -61,7 +61,7 @@ Positron::Positron(Positron&& other) noexcept : Particle(std::move(other))
 
 Positron& Positron::operator=(const Positron& other)
 {
-  std::cout<<"Positron copy assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Positron copy assignment operator called.");
   if(this != &other)
   {
     // Copy the positron properties
@@ -75,7 +75,7 @@ Positron& Positron::operator=(const Positron& other)
 
 Positron& Positron::operator=(Positron&& other) noexcept
 {
-  std::cout<<"Positron move assignment operator called. "<<std::endl;
+  DETECTOR_LOG_DEBUG("Positron move assignment operator called.");
   if(this != &other)
   {
     // Move the positron properties
@@ -116,11 +116,3 @@ void Positron::print() const
   std::cout<<"ID: "<<particle_id<<std::endl;
   std::cout<<"Charge (e): "<<particle_charge<<std::endl;
 }
-
-// Detection method
-bool Positron::can_be_detected_by(const std::string& detector_type) const
-{
-  // Check if the electron can be detected by the given detector type
-  if(detector_type == "EM Calorimeter" || detector_type == "Tracker") {return true;}
-  else {return false;}
-}
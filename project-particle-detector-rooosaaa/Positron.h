@@ -15,7 +15,8 @@
 // - The Rule of 5 methods for memory management, ensuring proper copying and moving of positron objects.
 // - Setter methods for setting the name and charge of the positron (both properties are validated).
 // - The `print` method to display the positron's details, such as name, four-momentum, ID, and charge.
-// - The `can_be_detected_by` method, which checks whether the positron can be detected by a given detector type.
+// - The `get_type` method returning the positron type code, which determines the sub-detectors that can
+//   detect it (see DetectionCapability.h)
 //
 // === COMPILATION AND EXECUTION ===
 //
@@ -48,16 +49,15 @@ namespace ParticleSystem
     // Destructor
     ~Positron();
 
+    // [GETTERS]
+    ParticleType get_type() const override {return ParticleType::Positron;}
+
     // [SETTERS]
     void set_name(std::string name) override;
     void set_charge(double charge) override;
     
     // [PRINT METHOD]
     void print() const override;
-    
-    // [DETECTION METHOD]
-    // Method to check if particle can be detected by a detector type
-    bool can_be_detected_by(const std::string& detector_type) const override;
   };
 } // namespace ParticleSystem
 
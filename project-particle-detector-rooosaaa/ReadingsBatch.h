@@ -0,0 +1,65 @@
+// ReadingsBatch.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `ReadingsBatch` structure, the output buffer of
+// `Detector::process_batch`. It stores the energy measured by each sub-detector as one
+// contiguous column per sub-detector, with one entry per particle of the input ParticleBatch.
+// The columns are indexed by `SubDetectorType`, matching the layout of `DetectorReadings`.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef READINGS_BATCH_H
+#define READINGS_BATCH_H
+
+#include<array>
+#include<cstddef>
+#include<vector>
+
+#include "DetectorReadings.h"
+#include "SubDetectorType.h"
+
+namespace ParticleDetector
+{
+  struct ReadingsBatch
+  {
+    // [COLUMNS]
+    // Energy in GeV measured by each sub-detector, one column per SubDetectorType
+    // and one entry per particle
+    std::array<std::vector<double>, DetectorSubsystems::number_of_sub_detector_types> energy_columns;
+
+    // [METHODS]
+    // Resize every column to hold the given number of particles
+    void resize(std::size_t particles)
+    {
+      for(auto& column : energy_columns) {column.resize(particles);}
+    }
+    // Return the column belonging to a sub-detector type
+    std::vector<double>& get_column(DetectorSubsystems::SubDetectorType type)
+    {
+      return energy_columns[static_cast<std::size_t>(type)];
+    }
+    const std::vector<double>& get_column(DetectorSubsystems::SubDetectorType type) const
+    {
+      return energy_columns[static_cast<std::size_t>(type)];
+    }
+    // Gather the readings of a single particle
+    DetectorReadings get_readings(std::size_t particle) const
+    {
+      DetectorReadings readings;
+      for(std::size_t type = 0; type < energy_columns.size(); ++type)
+      {
+        readings.energies[type] = energy_columns[type][particle];
+      }
+      return readings;
+    }
+
+    // [GETTERS]
+    std::size_t size() const {return energy_columns[0].size();}
+  };
+} // namespace ParticleDetector
+
+#endif // READINGS_BATCH_H
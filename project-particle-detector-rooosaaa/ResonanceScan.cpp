@@ -0,0 +1,298 @@
+// ResonanceScan.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the resonance mass-window scan. The window test runs on m^2 in
+// find_mass_window_hits, which has AVX-512 and AVX2 code paths compiled with per-function
+// target attributes (as in SmearingKernel.cpp); the few combinations that fall inside a
+// window are then checked against the pair rules and get their mass computed once.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<cmath>
+#include<stdexcept>
+#include<utility>
+
+#include "ResonanceScan.h"
+#include "SimdSupport.h"
+
+#if PARTICLE_DETECTOR_X86_SIMD
+#include<immintrin.h>
+#endif
+
+using namespace ParticleDetector;
+
+namespace
+{
+  // Massless systems whose m^2 is within rounding of zero have a mass of zero
+  constexpr double mass_squared_tolerance = 1e-10;
+
+  // m^2 of a base four-vector plus one particle, in the same order as the vector paths
+  inline double combined_mass_squared(const std::array<double, 4>& base, double px, double py, double pz,
+    double energy)
+  {
+    const double x = base[0] + px;
+    const double y = base[1] + py;
+    const double z = base[2] + pz;
+    const double e = base[3] + energy;
+    return e * e - (x * x + y * y + z * z);
+  }
+
+  // Reference implementation, also used for the tails of the vector loops
+  std::size_t find_hits_scalar(const std::array<double, 4>& base, const double* px, const double* py,
+    const double* pz, const double* energy, std::size_t first, std::size_t count, const double* lower,
+    const double* upper, std::size_t number_of_windows, std::uint32_t* hits, std::size_t number_of_hits)
+  {
+    for(std::size_t i = first; i < count; ++i)
+    {
+      const double mass_squared = combined_mass_squared(base, px[i], py[i], pz[i], energy[i]);
+      bool inside = false;
+      for(std::size_t w = 0; w < number_of_windows; ++w)
+      {
+        inside |= mass_squared >= lower[w] && mass_squared <= upper[w];
+      }
+      if(inside) {hits[number_of_hits++] = static_cast<std::uint32_t>(i);}
+    }
+    return number_of_hits;
+  }
+
+#if PARTICLE_DETECTOR_X86_SIMD
+  // Four combinations per iteration
+  __attribute__((target("avx2"), optimize("fp-contract=off")))
+  std::size_t find_hits_avx2(const std::array<double, 4>& base, const double* px, const double* py,
+    const double* pz, const double* energy, std::size_t count, const double* lower, const double* upper,
+    std::size_t number_of_windows, std::uint32_t* hits)
+  {
+    const __m256d base_x = _mm256_set1_pd(base[0]);
+    const __m256d base_y = _mm256_set1_pd(base[1]);
+    const __m256d base_z = _mm256_set1_pd(base[2]);
+    const __m256d base_e = _mm256_set1_pd(base[3]);
+    std::size_t number_of_hits = 0;
+    std::size_t i = 0;
+    for(; i + 4 <= count; i += 4)
+    {
+      const __m256d x = _mm256_add_pd(base_x, _mm256_loadu_pd(px + i));
+      const __m256d y = _mm256_add_pd(base_y, _mm256_loadu_pd(py + i));
+      const __m256d z = _mm256_add_pd(base_z, _mm256_loadu_pd(pz + i));
+      const __m256d e = _mm256_add_pd(base_e, _mm256_loadu_pd(energy + i));
+      const __m256d momentum_squared = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x, x), _mm256_mul_pd(y, y)),
+        _mm256_mul_pd(z, z));
+      const __m256d mass_squared = _mm256_sub_pd(_mm256_mul_pd(e, e), momentum_squared);
+      __m256d inside = _mm256_setzero_pd();
+      for(std::size_t w = 0; w < number_of_windows; ++w)
+      {
+        inside = _mm256_or_pd(inside, _mm256_and_pd(
+          _mm256_cmp_pd(mass_squared, _mm256_set1_pd(lower[w]), _CMP_GE_OQ),
+          _mm256_cmp_pd(mass_squared, _mm256_set1_pd(upper[w]), _CMP_LE_OQ)));
+      }
+      // Append the lanes inside a window (usually none)
+      for(unsigned int lanes = static_cast<unsigned int>(_mm256_movemask_pd(inside)); lanes != 0; lanes &= lanes - 1)
+      {
+        hits[number_of_hits++] = static_cast<std::uint32_t>(i + __builtin_ctz(lanes));
+      }
+    }
+    return find_hits_scalar(base, px, py, pz, energy, i, count, lower, upper, number_of_windows, hits,
+      number_of_hits);
+  }
+
+  // Eight combinations per iteration; the tail uses masked loads
+  __attribute__((target("avx512f"), optimize("fp-contract=off")))
+  std::size_t find_hits_avx512(const std::array<double, 4>& base, const double* px, const double* py,
+    const double* pz, const double* energy, std::size_t count, const double* lower, const double* upper,
+    std::size_t number_of_windows, std::uint32_t* hits)
+  {
+    const __m512d base_x = _mm512_set1_pd(base[0]);
+    const __m512d base_y = _mm512_set1_pd(base[1]);
+    const __m512d base_z = _mm512_set1_pd(base[2]);
+    const __m512d base_e = _mm512_set1_pd(base[3]);
+    std::size_t number_of_hits = 0;
+    for(std::size_t i = 0; i < count; i += 8)
+    {
+      const std::size_t remaining = count - i;
+      const __mmask8 lanes = remaining >= 8 ? 0xFF : static_cast<__mmask8>((1u << remaining) - 1);
+      const __m512d x = _mm512_add_pd(base_x, _mm512_maskz_loadu_pd(lanes, px + i));
+      const __m512d y = _mm512_add_pd(base_y, _mm512_maskz_loadu_pd(lanes, py + i));
+      const __m512d z = _mm512_add_pd(base_z, _mm512_maskz_loadu_pd(lanes, pz + i));
+      const __m512d e = _mm512_add_pd(base_e, _mm512_maskz_loadu_pd(lanes, energy + i));
+      const __m512d momentum_squared = _mm512_add_pd(_mm512_add_pd(_mm512_mul_pd(x, x), _mm512_mul_pd(y, y)),
+        _mm512_mul_pd(z, z));
+      const __m512d mass_squared = _mm512_sub_pd(_mm512_mul_pd(e, e), momentum_squared);
+      __mmask8 inside = 0;
+      for(std::size_t w = 0; w < number_of_windows; ++w)
+      {
+        inside |= _mm512_mask_cmp_pd_mask(
+          _mm512_cmp_pd_mask(mass_squared, _mm512_set1_pd(lower[w]), _CMP_GE_OQ),
+          mass_squared, _mm512_set1_pd(upper[w]), _CMP_LE_OQ);
+      }
+      for(unsigned int hit_lanes = inside & lanes; hit_lanes != 0; hit_lanes &= hit_lanes - 1)
+      {
+        hits[number_of_hits++] = static_cast<std::uint32_t>(i + __builtin_ctz(hit_lanes));
+      }
+    }
+    return number_of_hits;
+  }
+#endif
+}
+
+// [WINDOW TABLE]
+
+std::vector<ResonanceWindow> ParticleDetector::standard_resonance_windows()
+{
+  return {{"Higgs boson", 125.0, 10.0}, {"Z boson", 91.2, 5.0}, {"top quark", 173.0, 10.0}};
+}
+
+// [KERNEL]
+
+std::size_t ParticleDetector::find_mass_window_hits(const std::array<double, 4>& base, const double* px,
+  const double* py, const double* pz, const double* energy, std::size_t count, const double* lower_mass_squared,
+  const double* upper_mass_squared, std::size_t number_of_windows, std::uint32_t* hits)
+{
+#if PARTICLE_DETECTOR_X86_SIMD
+  switch(DetectorSimd::active_simd_level())
+  {
+    case DetectorSimd::SimdLevel::AVX512:
+      return find_hits_avx512(base, px, py, pz, energy, count, lower_mass_squared, upper_mass_squared,
+        number_of_windows, hits);
+    case DetectorSimd::SimdLevel::AVX2:
+      return find_hits_avx2(base, px, py, pz, energy, count, lower_mass_squared, upper_mass_squared,
+        number_of_windows, hits);
+    case DetectorSimd::SimdLevel::Scalar:
+      break;
+  }
+#endif
+  return find_hits_scalar(base, px, py, pz, energy, 0, count, lower_mass_squared, upper_mass_squared,
+    number_of_windows, hits, 0);
+}
+
+// [CONSTRUCTORS]
+
+ResonanceScanner::ResonanceScanner(std::vector<ResonanceWindow> resonance_windows,
+  const ResonanceScanOptions& scan_options) : windows{std::move(resonance_windows)}, options{scan_options}
+{
+  if(windows.size() > std::numeric_limits<std::uint16_t>::max()) {throw std::invalid_argument(
+    "Error: Too many resonance windows.");}
+  for(const auto& window : windows)
+  {
+    if(!(window.mass >= 0.0) || !(window.half_width >= 0.0)) {throw std::invalid_argument(
+      "Error: Resonance window " + window.name + " must have a non-negative mass and half width.");}
+    const double lower = window.mass - window.half_width;
+    const double upper = window.mass + window.half_width;
+    // A window reaching zero also accepts massless systems with rounding errors in m^2
+    lower_mass_squared.push_back(lower > 0.0 ? lower * lower : -mass_squared_tolerance);
+    upper_mass_squared.push_back(upper * upper);
+  }
+}
+
+// [GETTERS]
+
+std::size_t ResonanceScanner::find_window(const std::string& name) const
+{
+  for(std::size_t w = 0; w < windows.size(); ++w)
+  {
+    if(windows[w].name == name) {return w;}
+  }
+  throw std::invalid_argument("Error: No resonance window named " + name + ".");
+}
+
+// [PRIVATE METHODS]
+
+void ResonanceScanner::add_matches(double mass_squared, std::uint64_t event, std::uint32_t first_particle,
+  std::uint32_t second_particle, std::uint32_t third_particle, ResonanceCandidates& candidates) const
+{
+  // Same rounding rule as FourMomentum::calculate_invariant_mass
+  const double mass = mass_squared < 0.0 ? 0.0 : std::sqrt(mass_squared);
+  for(std::size_t w = 0; w < windows.size(); ++w)
+  {
+    if(mass_squared >= lower_mass_squared[w] && mass_squared <= upper_mass_squared[w])
+    {
+      candidates.add(event, first_particle, second_particle, third_particle, mass, static_cast<std::uint16_t>(w));
+    }
+  }
+}
+
+// [METHODS]
+
+void ResonanceScanner::scan_event(const ParticleSystem::ParticleBatchView& batch, std::size_t event,
+  ResonanceCandidates& candidates) const
+{
+  if(event >= batch.number_of_events()) {throw std::out_of_range("Error: Event index out of range.");}
+  if(windows.empty()) {return;}
+  const std::size_t begin = static_cast<std::size_t>(batch.event_offsets[event]);
+  const std::size_t particles = static_cast<std::size_t>(batch.event_offsets[event + 1]) - begin;
+  const double* px = batch.px + begin;
+  const double* py = batch.py + begin;
+  const double* pz = batch.pz + begin;
+  const double* energy = batch.energy + begin;
+  const double* charge = batch.charge + begin;
+  const ParticleSystem::ParticleType* type = batch.type + begin;
+  const std::uint64_t event_number = batch.first_event_number + event;
+  std::array<std::uint32_t, block_size> hits;
+
+  // Pairs (i, j) with i < j. The second particles are taken one block at a time and paired
+  // with every earlier particle, so each block stays in the cache while it is reused.
+  if(options.opposite_charge_pairs || options.same_flavour_pairs)
+  {
+    for(std::size_t block_start = 1; block_start < particles; block_start += block_size)
+    {
+      const std::size_t block_end = std::min(particles, block_start + block_size);
+      for(std::size_t i = 0; i + 1 < block_end; ++i)
+      {
+        const std::size_t first_j = std::max(i + 1, block_start);
+        const std::array<double, 4> base{px[i], py[i], pz[i], energy[i]};
+        const std::size_t number_of_hits = find_mass_window_hits(base, px + first_j, py + first_j, pz + first_j,
+          energy + first_j, block_end - first_j, lower_mass_squared.data(), upper_mass_squared.data(),
+          windows.size(), hits.data());
+        for(std::size_t h = 0; h < number_of_hits; ++h)
+        {
+          const std::size_t j = first_j + hits[h];
+          const bool opposite_charge = charge[i] * charge[j] < 0.0;
+          const bool same_flavour = particle_flavours[static_cast<std::size_t>(type[i])] ==
+            particle_flavours[static_cast<std::size_t>(type[j])];
+          if(!((options.opposite_charge_pairs && opposite_charge) || (options.same_flavour_pairs && same_flavour)))
+          {
+            continue;
+          }
+          add_matches(combined_mass_squared(base, px[j], py[j], pz[j], energy[j]), event_number,
+            static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j), ResonanceCandidates::no_particle,
+            candidates);
+        }
+      }
+    }
+  }
+
+  // Triplets (i, j, k) with i < j < k: the pair sum is the base of a scan over k
+  if(options.triplets)
+  {
+    for(std::size_t i = 0; i + 2 < particles; ++i)
+    {
+      for(std::size_t j = i + 1; j + 1 < particles; ++j)
+      {
+        const std::array<double, 4> base{px[i] + px[j], py[i] + py[j], pz[i] + pz[j], energy[i] + energy[j]};
+        for(std::size_t block_start = j + 1; block_start < particles; block_start += block_size)
+        {
+          const std::size_t block_end = std::min(particles, block_start + block_size);
+          const std::size_t number_of_hits = find_mass_window_hits(base, px + block_start, py + block_start,
+            pz + block_start, energy + block_start, block_end - block_start, lower_mass_squared.data(),
+            upper_mass_squared.data(), windows.size(), hits.data());
+          for(std::size_t h = 0; h < number_of_hits; ++h)
+          {
+            const std::size_t k = block_start + hits[h];
+            add_matches(combined_mass_squared(base, px[k], py[k], pz[k], energy[k]), event_number,
+              static_cast<std::uint32_t>(i), static_cast<std::uint32_t>(j), static_cast<std::uint32_t>(k),
+              candidates);
+          }
+        }
+      }
+    }
+  }
+}
+
+void ResonanceScanner::scan_batch(const ParticleSystem::ParticleBatchView& batch,
+  ResonanceCandidates& candidates) const
+{
+  for(std::size_t event = 0; event < batch.number_of_events(); ++event) {scan_event(batch, event, candidates);}
+}
@@ -0,0 +1,149 @@
+// ResonanceScan.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the resonance search of the analysis: a configurable table of
+// resonance mass windows (`ResonanceWindow`), and the `ResonanceScanner` class, which
+// computes the invariant mass of every pair (and optionally every triplet) of particles in
+// an event and records the combinations whose mass falls inside a window.
+//
+// Pairs are kept if they have opposite charges or the same flavour (an electron and a
+// positron are the same flavour); triplets are taken without a charge or flavour rule.
+// The scan is blocked so that the particles being paired stay in the L1 cache, and the
+// inner loop compares m^2 against the squared window edges with AVX2 or AVX-512 (selected
+// at run time, see SimdSupport.h), so only combinations inside a window need a square root.
+// Masses use the same definition and rounding as FourMomentum::calculate_invariant_mass.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef RESONANCE_SCAN_H
+#define RESONANCE_SCAN_H
+
+#include<array>
+#include<cmath>
+#include<cstddef>
+#include<cstdint>
+#include<limits>
+#include<string>
+#include<vector>
+
+#include "ParticleBatchView.h"
+#include "ParticleType.h"
+
+namespace ParticleDetector
+{
+  // Mass window of a resonance, [mass - half_width, mass + half_width], in GeV
+  struct ResonanceWindow
+  {
+    std::string name;
+    double mass;
+    double half_width;
+  };
+
+  // Windows of the resonances produced by the example events (Higgs, Z boson and top quark)
+  std::vector<ResonanceWindow> standard_resonance_windows();
+
+  // Flavour of each particle type (indexed by ParticleType): electrons and positrons share one
+  constexpr std::array<std::uint8_t, ParticleSystem::number_of_particle_types> particle_flavours = {0, 0, 1, 2, 3, 4};
+
+  // Which combinations of particles a scan considers
+  struct ResonanceScanOptions
+  {
+    bool opposite_charge_pairs = true; // pairs whose charges have opposite signs
+    bool same_flavour_pairs = true; // pairs of the same flavour
+    bool triplets = false; // every triplet of the event (O(n^3))
+  };
+
+  // Combinations found inside a window, one column per quantity and one entry per combination
+  struct ResonanceCandidates
+  {
+    // Index used for the third particle of a pair
+    static constexpr std::uint32_t no_particle = std::numeric_limits<std::uint32_t>::max();
+
+    // [COLUMNS]
+    std::vector<std::uint64_t> event_number; // global event number
+    std::vector<std::uint32_t> first; // particle indices within the event
+    std::vector<std::uint32_t> second;
+    std::vector<std::uint32_t> third; // no_particle for pairs
+    std::vector<double> mass; // invariant mass of the combination in GeV
+    std::vector<std::uint16_t> window; // index of the matching window
+
+    // [METHODS]
+    void clear()
+    {
+      event_number.clear();
+      first.clear();
+      second.clear();
+      third.clear();
+      mass.clear();
+      window.clear();
+    }
+    void add(std::uint64_t event, std::uint32_t first_particle, std::uint32_t second_particle,
+      std::uint32_t third_particle, double candidate_mass, std::uint16_t window_index)
+    {
+      event_number.push_back(event);
+      first.push_back(first_particle);
+      second.push_back(second_particle);
+      third.push_back(third_particle);
+      mass.push_back(candidate_mass);
+      window.push_back(window_index);
+    }
+
+    // [GETTERS]
+    std::size_t size() const {return event_number.size();}
+  };
+
+  class ResonanceScanner
+  {
+  private:
+    std::vector<ResonanceWindow> windows;
+    // Squared window edges, compared with m^2 so that only candidates need a square root
+    std::vector<double> lower_mass_squared;
+    std::vector<double> upper_mass_squared;
+    ResonanceScanOptions options;
+
+    // Record every window that a combination with the given m^2 falls in
+    void add_matches(double mass_squared, std::uint64_t event, std::uint32_t first_particle,
+      std::uint32_t second_particle, std::uint32_t third_particle, ResonanceCandidates& candidates) const;
+
+  public:
+    // Number of particles per block of the pair scan (4 columns of 512 doubles = 16 KiB)
+    static constexpr std::size_t block_size = 512;
+
+    // [CONSTRUCTORS]
+    // Parameterised constructor; throws if a window has a negative half width or mass
+    explicit ResonanceScanner(std::vector<ResonanceWindow> resonance_windows = standard_resonance_windows(),
+      const ResonanceScanOptions& scan_options = ResonanceScanOptions());
+
+    // [GETTERS]
+    const std::vector<ResonanceWindow>& get_windows() const {return windows;}
+    const ResonanceScanOptions& get_options() const {return options;}
+
+    // [METHODS]
+    // Scan one event of a batch and append its candidates
+    void scan_event(const ParticleSystem::ParticleBatchView& batch, std::size_t event,
+      ResonanceCandidates& candidates) const;
+    // Scan every event of a batch and append their candidates
+    void scan_batch(const ParticleSystem::ParticleBatchView& batch, ResonanceCandidates& candidates) const;
+    // Index of the window with the given name; throws if there is none
+    std::size_t find_window(const std::string& name) const;
+    // Whether a mass lies inside the window with the given index (edges included, as in the scan)
+    bool window_contains(std::size_t window, double mass) const
+    {
+      return std::abs(mass - windows.at(window).mass) <= windows[window].half_width;
+    }
+  };
+
+  // Find the combinations in [0, count) of the given columns whose invariant mass together
+  // with `base` (px, py, pz, E) has m^2 inside any of the `number_of_windows` squared
+  // windows. Writes their indices to `hits` (which must hold `count` entries) and returns
+  // the number of hits.
+  std::size_t find_mass_window_hits(const std::array<double, 4>& base, const double* px, const double* py,
+    const double* pz, const double* energy, std::size_t count, const double* lower_mass_squared,
+    const double* upper_mass_squared, std::size_t number_of_windows, std::uint32_t* hits);
+} // namespace ParticleDetector
+
+#endif // RESONANCE_SCAN_H
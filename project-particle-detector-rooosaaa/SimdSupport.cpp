@@ -0,0 +1,70 @@
+// SimdSupport.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the runtime SIMD level selection. The CPU is queried once, and
+// the active level is kept in an atomic variable so kernels on any thread can read it.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<atomic>
+
+#include "SimdSupport.h"
+
+namespace DetectorSimd
+{
+  namespace
+  {
+    // Query the CPU for the best supported level
+    SimdLevel query_cpu()
+    {
+#if PARTICLE_DETECTOR_X86_SIMD
+      __builtin_cpu_init();
+      if(__builtin_cpu_supports("avx512f")) {return SimdLevel::AVX512;}
+      if(__builtin_cpu_supports("avx2")) {return SimdLevel::AVX2;}
+#endif
+      return SimdLevel::Scalar;
+    }
+
+    // Active level, -1 until first use (then initialised to the detected level)
+    std::atomic<int> selected_level{-1};
+  }
+
+  SimdLevel detected_simd_level()
+  {
+    static const SimdLevel detected = query_cpu();
+    return detected;
+  }
+
+  SimdLevel active_simd_level()
+  {
+    int level = selected_level.load(std::memory_order_relaxed);
+    if(level < 0)
+    {
+      level = static_cast<int>(detected_simd_level());
+      selected_level.store(level, std::memory_order_relaxed);
+    }
+    return static_cast<SimdLevel>(level);
+  }
+
+  void set_simd_level(SimdLevel level)
+  {
+    // Never select instructions that the CPU cannot execute
+    if(static_cast<int>(level) > static_cast<int>(detected_simd_level())) {level = detected_simd_level();}
+    selected_level.store(static_cast<int>(level), std::memory_order_relaxed);
+  }
+
+  const char* simd_level_name(SimdLevel level)
+  {
+    switch(level)
+    {
+      case SimdLevel::Scalar: return "Scalar";
+      case SimdLevel::AVX2: return "AVX2";
+      case SimdLevel::AVX512: return "AVX-512";
+    }
+    return "Unknown";
+  }
+} // namespace DetectorSimd
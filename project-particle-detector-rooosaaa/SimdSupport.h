@@ -0,0 +1,54 @@
+// SimdSupport.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file provides runtime selection of the SIMD instruction set used by the
+// column kernels (e.g. the batch smearing kernel). The program is compiled for the baseline
+// x86-64 instruction set; kernels that have AVX2 or AVX-512 code paths compile those paths
+// with per-function target attributes and pick one at run time based on the CPU.
+//
+// The selected level can be lowered with set_simd_level, e.g. to compare a vector code path
+// against the scalar reference on the same machine.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef SIMD_SUPPORT_H
+#define SIMD_SUPPORT_H
+
+#include<cstddef>
+
+// Vector code paths are only built for x86 with a GCC-compatible compiler
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#define PARTICLE_DETECTOR_X86_SIMD 1
+#else
+#define PARTICLE_DETECTOR_X86_SIMD 0
+#endif
+
+namespace DetectorSimd
+{
+  // Size of a cache line on the targeted x86-64 and ARM64 machines; data written by
+  // different threads is kept this far apart to avoid false sharing
+  constexpr std::size_t cache_line_size = 64;
+
+  // Instruction set levels, in increasing order of capability
+  enum class SimdLevel : int
+  {
+    Scalar = 0,
+    AVX2 = 1,
+    AVX512 = 2
+  };
+
+  // Highest level supported by the CPU running the program
+  SimdLevel detected_simd_level();
+  // Level the kernels currently use (defaults to the detected level)
+  SimdLevel active_simd_level();
+  // Select the level used by the kernels; requests above the detected level are lowered to it
+  void set_simd_level(SimdLevel level);
+  // Return the display name of a level
+  const char* simd_level_name(SimdLevel level);
+} // namespace DetectorSimd
+
+#endif // SIMD_SUPPORT_H
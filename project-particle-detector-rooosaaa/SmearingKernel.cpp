@@ -0,0 +1,105 @@
+// SmearingKernel.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the batch Gaussian smearing kernel. The vector code paths are
+// compiled with per-function target attributes, so the rest of the program does not need
+// to be built for AVX2 or AVX-512. Floating-point contraction is disabled for the vector
+// paths so that no fused multiply-add changes the rounding compared to the scalar path; the
+// scalar path needs the program to be built with -ffp-contract=off (see SmearingKernel.h).
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<cmath>
+
+#include "SmearingKernel.h"
+#include "SimdSupport.h"
+
+#if PARTICLE_DETECTOR_X86_SIMD
+#include<immintrin.h>
+#endif
+
+namespace DetectorSubsystems
+{
+  namespace
+  {
+    // Reference implementation, also used for the tails of the vector loops
+    void smear_energies_scalar(const double* energies, const double* draws, double* measured,
+      std::size_t first, std::size_t count, double energy_loss_fraction, double relative_width)
+    {
+      for(std::size_t i = first; i < count; ++i)
+      {
+        double mean = energies[i] * energy_loss_fraction;
+        double std_dev = mean * relative_width;
+        measured[i] = std::abs(mean + std_dev * draws[i]);
+      }
+    }
+
+#if PARTICLE_DETECTOR_X86_SIMD
+    // Four energies per iteration
+    __attribute__((target("avx2"), optimize("fp-contract=off")))
+    void smear_energies_avx2(const double* energies, const double* draws, double* measured,
+      std::size_t count, double energy_loss_fraction, double relative_width)
+    {
+      const __m256d fraction = _mm256_set1_pd(energy_loss_fraction);
+      const __m256d width = _mm256_set1_pd(relative_width);
+      const __m256d sign_bit = _mm256_set1_pd(-0.0);
+      std::size_t i = 0;
+      for(; i + 4 <= count; i += 4)
+      {
+        const __m256d mean = _mm256_mul_pd(_mm256_loadu_pd(energies + i), fraction);
+        const __m256d std_dev = _mm256_mul_pd(mean, width);
+        const __m256d value = _mm256_add_pd(mean, _mm256_mul_pd(std_dev, _mm256_loadu_pd(draws + i)));
+        // Clearing the sign bit is the absolute value
+        _mm256_storeu_pd(measured + i, _mm256_andnot_pd(sign_bit, value));
+      }
+      smear_energies_scalar(energies, draws, measured, i, count, energy_loss_fraction, relative_width);
+    }
+
+    // Eight energies per iteration; the tail uses masked loads and stores
+    __attribute__((target("avx512f"), optimize("fp-contract=off")))
+    void smear_energies_avx512(const double* energies, const double* draws, double* measured,
+      std::size_t count, double energy_loss_fraction, double relative_width)
+    {
+      const __m512d fraction = _mm512_set1_pd(energy_loss_fraction);
+      const __m512d width = _mm512_set1_pd(relative_width);
+      for(std::size_t i = 0; i < count; i += 8)
+      {
+        const std::size_t remaining = count - i;
+        const __mmask8 lanes = remaining >= 8 ? 0xFF : static_cast<__mmask8>((1u << remaining) - 1);
+        const __m512d mean = _mm512_mul_pd(_mm512_maskz_loadu_pd(lanes, energies + i), fraction);
+        const __m512d std_dev = _mm512_mul_pd(mean, width);
+        const __m512d value = _mm512_add_pd(mean, _mm512_mul_pd(std_dev, _mm512_maskz_loadu_pd(lanes, draws + i)));
+        _mm512_mask_storeu_pd(measured + i, lanes, _mm512_abs_pd(value));
+      }
+    }
+#endif
+  }
+
+  void smear_energies(const double* energies, const double* standard_normal_draws,
+    double* measured_energies, std::size_t count, double energy_loss_fraction, int resolution)
+  {
+    // Same expression as SubDetector::measure_energy, so both give identical widths
+    const double relative_width = resolution / 100.0;
+#if PARTICLE_DETECTOR_X86_SIMD
+    switch(DetectorSimd::active_simd_level())
+    {
+      case DetectorSimd::SimdLevel::AVX512:
+        smear_energies_avx512(energies, standard_normal_draws, measured_energies, count,
+          energy_loss_fraction, relative_width);
+        return;
+      case DetectorSimd::SimdLevel::AVX2:
+        smear_energies_avx2(energies, standard_normal_draws, measured_energies, count,
+          energy_loss_fraction, relative_width);
+        return;
+      case DetectorSimd::SimdLevel::Scalar:
+        break;
+    }
+#endif
+    smear_energies_scalar(energies, standard_normal_draws, measured_energies, 0, count,
+      energy_loss_fraction, relative_width);
+  }
+} // namespace DetectorSubsystems
@@ -0,0 +1,37 @@
+// SmearingKernel.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file declares the batch Gaussian smearing kernel used by the detector's batch
+// path. It applies the same model as SubDetector::measure_energy to a whole array of energies:
+//
+//   measured = | E * f + E * f * (resolution / 100) * z |
+//
+// where f is the sub-detector's energy loss fraction and z is a standard normal draw.
+//
+// The kernel has AVX-512 and AVX2 code paths and a scalar fallback, selected at run time
+// (see SimdSupport.h). Every path performs the same multiplications and additions in the
+// same order without fused multiply-add, so the results are bit-identical to the scalar
+// measure_energy whichever path runs. The vector paths turn contraction off themselves; the
+// scalar fallback and measure_energy (inlined into its callers) rely on the program being
+// built with -ffp-contract=off, as in the README.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef SMEARING_KERNEL_H
+#define SMEARING_KERNEL_H
+
+#include<cstddef>
+
+namespace DetectorSubsystems
+{
+  // Smear `count` energies using one standard normal draw per energy. The input and output
+  // arrays may be the same array (in-place smearing) but must not otherwise overlap.
+  void smear_energies(const double* energies, const double* standard_normal_draws,
+    double* measured_energies, std::size_t count, double energy_loss_fraction, int resolution);
+} // namespace DetectorSubsystems
+
+#endif // SMEARING_KERNEL_H
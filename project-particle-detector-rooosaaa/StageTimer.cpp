@@ -0,0 +1,231 @@
+// StageTimer.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the stage timing facility. Every thread that records a stage gets
+// its own set of totals, registered in a list of live threads; when the thread ends, its
+// totals are added to the totals of the finished threads. Only the owning thread writes its
+// totals, so they are relaxed atomics: a report can read them while other threads are still
+// running without a data race, and recording costs no more than plain additions.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<array>
+#include<atomic>
+#include<iomanip>
+#include<mutex>
+
+#include "StageTimer.h"
+
+namespace DetectorMetrics
+{
+  namespace
+  {
+    struct ThreadTotals
+    {
+      std::array<std::atomic<std::uint64_t>, number_of_stages> ticks{};
+      std::array<std::atomic<std::uint64_t>, number_of_stages> calls{};
+      std::array<std::atomic<std::uint64_t>, number_of_stages> items{};
+    };
+
+    // Add to a counter written only by the calling thread
+    inline void add(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+    {
+      counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+    }
+
+    // Totals of the live threads and of the threads that have finished
+    struct Registry
+    {
+      std::mutex mutex;
+      std::vector<ThreadTotals*> live_threads;
+      ThreadTotals finished_threads;
+    };
+
+    Registry& registry()
+    {
+      static Registry instance;
+      return instance;
+    }
+
+    // Registers the totals of a thread on its first recorded stage, and folds them into the
+    // finished totals when the thread ends
+    struct ThreadRegistration
+    {
+      ThreadTotals totals;
+      ThreadRegistration()
+      {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        registry().live_threads.push_back(&totals);
+      }
+      ~ThreadRegistration()
+      {
+        Registry& shared = registry();
+        std::lock_guard<std::mutex> lock(shared.mutex);
+        for(std::size_t stage = 0; stage < number_of_stages; ++stage)
+        {
+          add(shared.finished_threads.ticks[stage], totals.ticks[stage].load(std::memory_order_relaxed));
+          add(shared.finished_threads.calls[stage], totals.calls[stage].load(std::memory_order_relaxed));
+          add(shared.finished_threads.items[stage], totals.items[stage].load(std::memory_order_relaxed));
+        }
+        shared.live_threads.erase(std::find(shared.live_threads.begin(), shared.live_threads.end(), &totals));
+      }
+    };
+
+    ThreadTotals& thread_totals()
+    {
+      thread_local ThreadRegistration registration;
+      return registration.totals;
+    }
+
+    // Nanoseconds per clock tick, measured once against steady_clock over a few milliseconds
+    double nanoseconds_per_tick()
+    {
+#if PARTICLE_DETECTOR_TSC_CLOCK
+      static const double calibration = []
+      {
+        const auto start_time = std::chrono::steady_clock::now();
+        const std::uint64_t start_ticks = read_ticks();
+        std::chrono::steady_clock::time_point end_time;
+        do {end_time = std::chrono::steady_clock::now();}
+        while(end_time - start_time < std::chrono::milliseconds(5));
+        const std::uint64_t end_ticks = read_ticks();
+        return std::chrono::duration<double, std::nano>(end_time - start_time).count() /
+          static_cast<double>(end_ticks - start_ticks);
+      }();
+      return calibration;
+#else
+      return 1.0;
+#endif
+    }
+  }
+
+  const char* stage_name(Stage stage)
+  {
+    switch(stage)
+    {
+      case Stage::EventGeneration: return "Event generation";
+      case Stage::DetectParticle: return "Detect particle";
+      case Stage::Tracker: return "  Tracker";
+      case Stage::EMCalorimeter: return "  EM Calorimeter";
+      case Stage::HadronicCalorimeter: return "  Hadronic Calorimeter";
+      case Stage::MuonSpectrometer: return "  Muon Spectrometer";
+      case Stage::IdentifyParticle: return "Identify particle";
+      case Stage::InvariantMass: return "Invariant mass";
+      case Stage::MissingEnergy: return "Missing energy";
+      case Stage::ProcessBatch: return "Process batch";
+      case Stage::IdentifyBatch: return "Identify batch";
+      case Stage::SummariseBatch: return "Summarise batch";
+    }
+    return "Unknown";
+  }
+
+  void record(Stage stage, std::uint64_t ticks, std::uint64_t items)
+  {
+    ThreadTotals& totals = thread_totals();
+    const std::size_t index = static_cast<std::size_t>(stage);
+    add(totals.ticks[index], ticks);
+    add(totals.calls[index], 1);
+    add(totals.items[index], items);
+  }
+
+  // [REPORT]
+
+  std::vector<StageTotals> collect_totals()
+  {
+    std::array<std::uint64_t, number_of_stages> ticks{}, calls{}, items{};
+    {
+      Registry& shared = registry();
+      std::lock_guard<std::mutex> lock(shared.mutex);
+      auto sum = [&](const ThreadTotals& totals)
+      {
+        for(std::size_t stage = 0; stage < number_of_stages; ++stage)
+        {
+          ticks[stage] += totals.ticks[stage].load(std::memory_order_relaxed);
+          calls[stage] += totals.calls[stage].load(std::memory_order_relaxed);
+          items[stage] += totals.items[stage].load(std::memory_order_relaxed);
+        }
+      };
+      sum(shared.finished_threads);
+      for(const ThreadTotals* totals : shared.live_threads) {sum(*totals);}
+    }
+    const double ns_per_tick = nanoseconds_per_tick();
+    std::vector<StageTotals> stages;
+    for(std::size_t stage = 0; stage < number_of_stages; ++stage)
+    {
+      if(calls[stage] == 0) {continue;}
+      stages.push_back(StageTotals{static_cast<Stage>(stage), calls[stage], items[stage],
+        static_cast<double>(ticks[stage]) * ns_per_tick});
+    }
+    return stages;
+  }
+
+  void reset()
+  {
+    Registry& shared = registry();
+    std::lock_guard<std::mutex> lock(shared.mutex);
+    auto clear = [](ThreadTotals& totals)
+    {
+      for(std::size_t stage = 0; stage < number_of_stages; ++stage)
+      {
+        totals.ticks[stage].store(0, std::memory_order_relaxed);
+        totals.calls[stage].store(0, std::memory_order_relaxed);
+        totals.items[stage].store(0, std::memory_order_relaxed);
+      }
+    };
+    clear(shared.finished_threads);
+    for(ThreadTotals* totals : shared.live_threads) {clear(*totals);}
+  }
+
+  void print_report(std::ostream& output)
+  {
+    const auto stages = collect_totals();
+    const auto flags = output.flags();
+    const auto precision = output.precision();
+    output<<"\n=== [Stage Timing Report] ===\n"<<std::endl;
+    if(stages.empty()) {output<<"No stages were timed."<<std::endl;}
+    else
+    {
+      output<<std::left<<std::setw(24)<<"Stage"<<std::right<<std::setw(12)<<"Calls"<<std::setw(14)<<"Items"
+        <<std::setw(14)<<"Total (ms)"<<std::setw(12)<<"ns/call"<<std::setw(12)<<"ns/item"<<std::endl;
+      output<<std::fixed;
+      for(const auto& stage : stages)
+      {
+        output<<std::left<<std::setw(24)<<stage_name(stage.stage)<<std::right<<std::setw(12)<<stage.calls
+          <<std::setw(14)<<stage.items<<std::setprecision(3)<<std::setw(14)<<stage.total_ns * 1e-6
+          <<std::setprecision(1)<<std::setw(12)<<stage.total_ns / static_cast<double>(stage.calls)<<std::setw(12)
+          <<(stage.items > 0 ? stage.total_ns / static_cast<double>(stage.items) : 0.0)<<std::endl;
+      }
+    }
+    output.flags(flags);
+    output.precision(precision);
+  }
+
+  void write_json(std::ostream& output)
+  {
+    const auto stages = collect_totals();
+    const auto flags = output.flags();
+    const auto precision = output.precision();
+    output<<std::defaultfloat<<std::setprecision(9);
+    output<<"{\n  \"clock\": \""<<(PARTICLE_DETECTOR_TSC_CLOCK ? "tsc" : "steady_clock")<<"\",\n  \"stages\": ["
+      <<std::endl;
+    for(std::size_t i = 0; i < stages.size(); ++i)
+    {
+      const auto& stage = stages[i];
+      // Sub-detector names are indented in the table only
+      const char* name = stage_name(stage.stage);
+      while(*name == ' ') {++name;}
+      output<<"    {\"stage\": \""<<name<<"\", \"calls\": "<<stage.calls<<", \"items\": "<<stage.items
+        <<", \"total_ns\": "<<stage.total_ns<<", \"ns_per_call\": "<<stage.total_ns / static_cast<double>(stage.calls)
+        <<", \"ns_per_item\": "<<(stage.items > 0 ? stage.total_ns / static_cast<double>(stage.items) : 0.0)<<"}"
+        <<(i + 1 < stages.size() ? "," : "")<<std::endl;
+    }
+    output<<"  ]\n}"<<std::endl;
+    output.flags(flags);
+    output.precision(precision);
+  }
+} // namespace DetectorMetrics
@@ -0,0 +1,150 @@
+// StageTimer.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the stage timing facility, which measures where the time of a
+// run goes: event generation, detection (in total and per sub-detector type),
+// identification, invariant mass and MET, and the batch stages.
+//
+// A stage is timed by a `ScopedStageTimer` placed at the top of its scope (normally through
+// the DETECTOR_TIME_STAGE macro). The timer adds the elapsed clock ticks, one call and a
+// number of items to the totals of the calling thread. Every stage counts particles, so the
+// ns/item column means the same for all of them. Each thread has its
+// own totals, written only by that thread, so timing never takes a lock or contends for a
+// cache line. The totals of all threads (including finished ones) are summed when a report
+// is made with `print_report` (table) or `write_json`.
+//
+// On x86 the clock is the time-stamp counter (TSC), which costs a few nanoseconds to read and
+// is converted to nanoseconds by calibrating it against std::chrono::steady_clock; elsewhere
+// steady_clock is used directly. Timers are compiled in by default; building with
+// -DPARTICLE_DETECTOR_METRICS=0 turns the macro into an empty statement, so the timed code
+// is exactly the same as without instrumentation:
+//
+//   g++-11 -std=gnu++20 -DPARTICLE_DETECTOR_METRICS=0 ...
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef STAGE_TIMER_H
+#define STAGE_TIMER_H
+
+#include<chrono>
+#include<cstddef>
+#include<cstdint>
+#include<ostream>
+#include<vector>
+
+#include "SubDetectorType.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include<x86intrin.h>
+#define PARTICLE_DETECTOR_TSC_CLOCK 1
+#else
+#define PARTICLE_DETECTOR_TSC_CLOCK 0
+#endif
+
+// Whether the stage timers are compiled into the program
+#ifndef PARTICLE_DETECTOR_METRICS
+#define PARTICLE_DETECTOR_METRICS 1
+#endif
+
+namespace DetectorMetrics
+{
+  // Timed stages of a run; the sub-detector stages follow the order of SubDetectorType
+  enum class Stage : std::uint8_t
+  {
+    EventGeneration = 0,
+    DetectParticle = 1,
+    Tracker = 2,
+    EMCalorimeter = 3,
+    HadronicCalorimeter = 4,
+    MuonSpectrometer = 5,
+    IdentifyParticle = 6,
+    InvariantMass = 7,
+    MissingEnergy = 8,
+    ProcessBatch = 9,
+    IdentifyBatch = 10,
+    SummariseBatch = 11
+  };
+
+  // Number of distinct stages, useful for sizing the per-thread totals
+  constexpr std::size_t number_of_stages = 12;
+
+  // Return the display name of a stage
+  const char* stage_name(Stage stage);
+
+  // Return the stage timing one sub-detector type
+  inline Stage sub_detector_stage(DetectorSubsystems::SubDetectorType type)
+  {
+    return static_cast<Stage>(static_cast<std::size_t>(Stage::Tracker) + static_cast<std::size_t>(type));
+  }
+
+  // Current time in clock ticks (TSC cycles on x86, steady_clock nanoseconds otherwise)
+  inline std::uint64_t read_ticks()
+  {
+#if PARTICLE_DETECTOR_TSC_CLOCK
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+  }
+
+  // Add one call of a stage, lasting `ticks` and handling `items` items, to the calling
+  // thread's totals
+  void record(Stage stage, std::uint64_t ticks, std::uint64_t items);
+
+  class ScopedStageTimer
+  {
+  private:
+    Stage stage;
+    std::uint64_t items;
+    std::uint64_t start;
+
+  public:
+    // Start timing a stage that handles the given number of items
+    explicit ScopedStageTimer(Stage timed_stage, std::uint64_t number_of_items = 1) :
+      stage{timed_stage}, items{number_of_items}, start{read_ticks()} {}
+    // A timer measures exactly one scope
+    ScopedStageTimer(const ScopedStageTimer& other) = delete;
+    ScopedStageTimer(ScopedStageTimer&& other) = delete;
+    ScopedStageTimer& operator=(const ScopedStageTimer& other) = delete;
+    ScopedStageTimer& operator=(ScopedStageTimer&& other) = delete;
+    // Stop timing and record the call
+    ~ScopedStageTimer() {record(stage, read_ticks() - start, items);}
+  };
+
+  // Totals of one stage over all threads
+  struct StageTotals
+  {
+    Stage stage;
+    std::uint64_t calls;
+    std::uint64_t items;
+    double total_ns;
+  };
+
+  // [REPORT]
+  // Totals of every stage that was called at least once, summed over all threads
+  std::vector<StageTotals> collect_totals();
+  // Clear the totals of all threads (must not run while stages are being timed)
+  void reset();
+  // Print the totals as a table
+  void print_report(std::ostream& output);
+  // Write the totals as a JSON document
+  void write_json(std::ostream& output);
+} // namespace DetectorMetrics
+
+// Time the rest of the enclosing scope as one call of a stage handling `items` items.
+// Compiles to nothing when PARTICLE_DETECTOR_METRICS is 0 (and `items` is not evaluated).
+#if PARTICLE_DETECTOR_METRICS
+#define DETECTOR_METRICS_CONCATENATE_(a, b) a##b
+#define DETECTOR_METRICS_CONCATENATE(a, b) DETECTOR_METRICS_CONCATENATE_(a, b)
+#define DETECTOR_TIME_STAGE(stage, items) \
+  DetectorMetrics::ScopedStageTimer DETECTOR_METRICS_CONCATENATE(stage_timer_, __LINE__)((stage), (items))
+#else
+#define DETECTOR_TIME_STAGE(stage, items) do {} while(false)
+#endif
+
+#endif // STAGE_TIMER_H
@@ -0,0 +1,185 @@
+// StaticDetector.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `StaticDetector` class template, a compile-time alternative
+// to the Detector class. The sub-detectors are held by value in a std::tuple instead of a
+// vector of pointers, and the chain of sub-detectors is expanded at compile time, so each
+// detection step is a direct (inlinable) call with no virtual dispatch or pointer chasing.
+//
+// The "exactly one of each sub-detector type" rule of Detector::validate_sub_detector_configuration
+// is checked with a static_assert, so an invalid detector type does not compile. The
+// sub-detectors are set up with the same configuration classes as Detector (see
+// DetectorConfig.h), and both detectors give identical readings for the same run seed when
+// the program is built with -ffp-contract=off (as in the README). Otherwise the compiler may
+// fuse the inlined smearing into a multiply-add, which rounds differently from the batch
+// kernel (see SmearingKernel.h).
+//
+// Example:
+//   StandardStaticDetector<ATLASConfig> detector;
+//   detector.set_detector_status(true);
+//   DetectorReadings readings = detector.detect_particle(photon, event_number, 0);
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef STATIC_DETECTOR_H
+#define STATIC_DETECTOR_H
+
+#include<array>
+#include<cstddef>
+#include<cstdint>
+#include<stdexcept>
+#include<tuple>
+#include<type_traits>
+
+#include "CounterRandom.h"
+#include "DetectionCapability.h"
+#include "DetectorConfig.h"
+#include "DetectorReadings.h"
+#include "Particle.h"
+#include "ParticleBatchView.h"
+#include "ReadingsBatch.h"
+#include "SubDetector.h"
+#include "SubDetectorType.h"
+
+namespace ParticleDetector
+{
+  // Check at compile time that a list of sub-detector classes holds exactly one of each type
+  template<typename... Stages>
+  constexpr bool has_one_of_each_sub_detector()
+  {
+    for(std::size_t type = 0; type < DetectorSubsystems::number_of_sub_detector_types; ++type)
+    {
+      const std::size_t count = ((static_cast<std::size_t>(Stages::static_type_id) == type ? 1 : 0) + ... + 0);
+      if(count != 1) {return false;}
+    }
+    return true;
+  }
+
+  // Detector whose sub-detectors (in detection order) and configuration are fixed at compile time
+  template<typename Config, typename... Stages>
+  class StaticDetector
+  {
+    static_assert((std::is_base_of_v<DetectorSubsystems::SubDetector, Stages> && ...),
+      "Every stage of a StaticDetector must be a SubDetector");
+    static_assert(sizeof...(Stages) == DetectorSubsystems::number_of_sub_detector_types &&
+      has_one_of_each_sub_detector<Stages...>(),
+      "A detector needs exactly one Tracker, EM Calorimeter, Hadronic Calorimeter and Muon Spectrometer");
+
+  private:
+    std::tuple<Stages...> sub_detectors;
+    bool detector_status; // true if on, false if off
+    std::uint64_t run_seed; // seed of the counter-based random streams (see Detector)
+
+    // Pass a particle's energy through one sub-detector and record the measurement
+    template<typename Stage>
+    void detect_stage(const Stage& stage, const ParticleSystem::Particle& particle, std::uint64_t event_number,
+      std::uint32_t particle_index, double& energy, DetectorReadings& readings) const
+    {
+      const double detected_energy = stage.detect_particle(particle, energy, run_seed, event_number, particle_index);
+      readings[Stage::static_type_id] = detected_energy;
+      if(detected_energy != 0.0) {energy = detected_energy;}
+    }
+    // Batch version of detect_stage, with the draw keyed like Detector::process_batch
+    template<typename Stage>
+    void detect_batch_stage(const Stage& stage, ParticleSystem::ParticleType type, DetectorRandom::RandomStreamKey stream,
+      double& energy, double& reading) const
+    {
+      if(!DetectorSubsystems::can_be_detected(type, Stage::static_type_id)) {reading = 0.0; return;}
+      stream.sub_detector = static_cast<std::uint32_t>(Stage::static_type_id);
+      const double draw = stage.get_resolution() == 0 ? 0.0 : DetectorRandom::standard_normal(stream);
+      reading = stage.measure_energy(energy, draw);
+      if(reading != 0.0) {energy = reading;}
+    }
+
+  public:
+    // [RULE OF 5]
+    // Default constructor: applies the configuration's settings to every sub-detector
+    StaticDetector() : detector_status{false}, run_seed{DetectorRandom::default_run_seed}
+    {
+      std::apply([](Stages&... stage) {(Config::configure(stage), ...);}, sub_detectors);
+    }
+    // Not allowing copy or move operations, like the sub-detectors it contains
+    // Copy constructor
+    StaticDetector(const StaticDetector& other) = delete;
+    // Move constructor
+    StaticDetector(StaticDetector&& other) = delete;
+    // Copy assignment operator
+    StaticDetector& operator=(const StaticDetector& other) = delete;
+    // Move assignment operator
+    StaticDetector& operator=(StaticDetector&& other) = delete;
+    // Destructor
+    ~StaticDetector() = default;
+
+    // [GETTERS]
+    bool get_detector_status() const {return detector_status;}
+    std::uint64_t get_run_seed() const {return run_seed;}
+    // Access a sub-detector by its class, e.g. get_sub_detector<Tracker>()
+    template<typename Stage> const Stage& get_sub_detector() const {return std::get<Stage>(sub_detectors);}
+
+    // [SETTERS]
+    void set_detector_status(bool status) {detector_status = status;}
+    // Set the run seed used for all smearing draws, on the object and batch paths alike
+    void set_run_seed(std::uint64_t seed) {run_seed = seed;}
+
+    // [DETECTOR METHODS]
+    // Detect a particle and return the energy measured by each sub-detector
+    // (same model and random streams as Detector::detect_particle)
+    DetectorReadings detect_particle(const ParticleSystem::Particle& particle, std::uint64_t event_number,
+      std::uint32_t particle_index) const
+    {
+      if(detector_status == false) {throw std::invalid_argument(
+        "Error: Detector is switched off. Cannot detect particles. Exiting program.");}
+      const auto& momentum = particle.get_momentum();
+      if(momentum.get_energy() <= 0 && momentum.get_px() == 0 && momentum.get_py() == 0 && momentum.get_pz() == 0)
+      {
+        throw std::invalid_argument("Error: Particle has no momentum. Cannot detect particle.");
+      }
+      DetectorReadings readings;
+      double energy = momentum.get_energy();
+      // Expands to one detect_stage call per sub-detector, in detection order
+      std::apply([&](const Stages&... stage) {(detect_stage(stage, particle, event_number, particle_index, energy,
+        readings), ...);},
+        sub_detectors);
+      return readings;
+    }
+
+    // Detect every particle of a batch on the calling thread; the readings are identical
+    // to those of Detector::process_batch with the same configuration and run seed (when
+    // built with -ffp-contract=off)
+    void process_batch(const ParticleSystem::ParticleBatchView& batch, ReadingsBatch& readings) const
+    {
+      if(detector_status == false) {throw std::invalid_argument(
+        "Error: Detector is switched off. Cannot detect particles. Exiting program.");}
+      readings.resize(batch.number_of_particles());
+      std::array<double*, DetectorSubsystems::number_of_sub_detector_types> columns;
+      for(std::size_t type = 0; type < columns.size(); ++type) {columns[type] = readings.energy_columns[type].data();}
+      for(std::size_t event = 0; event < batch.number_of_events(); ++event)
+      {
+        const DetectorRandom::RandomStreamKey event_stream{run_seed, batch.first_event_number + event, 0, 0};
+        for(std::uint64_t i = batch.event_offsets[event]; i < batch.event_offsets[event + 1]; ++i)
+        {
+          DetectorRandom::RandomStreamKey stream = event_stream;
+          stream.particle_index = static_cast<std::uint32_t>(i - batch.event_offsets[event]);
+          double energy = batch.energy[i];
+          std::apply([&](const Stages&... stage)
+          {
+            (detect_batch_stage(stage, batch.type[i], stream, energy,
+              columns[static_cast<std::size_t>(Stages::static_type_id)][i]), ...);
+          }, sub_detectors);
+        }
+      }
+    }
+  };
+
+  // Standard detector layout in detection order, configured by e.g. ATLASConfig or CMSConfig
+  template<typename Config>
+  using StandardStaticDetector = StaticDetector<Config, DetectorSubsystems::Tracker,
+    DetectorSubsystems::EMCalorimeter, DetectorSubsystems::HadronicCalorimeter,
+    DetectorSubsystems::MuonSpectrometer>;
+} // namespace ParticleDetector
+
+#endif // STATIC_DETECTOR_H
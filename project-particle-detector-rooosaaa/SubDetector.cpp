@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include "SubDetector.h"
+#include "SmearingKernel.h"
 
 using namespace DetectorSubsystems;
 
@@ -31,11 +32,10 @@ using namespace DetectorSubsystems;
 // [CONSTRUCTORS/DESTRUCTORS]
 
 SubDetector::SubDetector(const std::string& name, int resolution, double energy_loss)
- : sub_detector_type(name)
+ : sub_detector_type(name), sub_detector_type_id(sub_detector_type_from_name(name))
 {
   set_resolution(resolution);
   set_energy_loss_fraction(energy_loss);
-  random_generator.seed(random_device()); // Seed the random generator
 }
 
 SubDetector::~SubDetector()
@@ -76,22 +76,10 @@ void SubDetector::set_energy_loss_fraction(double energy_loss)
 
 // [METHODS]
 
-// Method to detect a particle
-double SubDetector::detect_particle(const Particle& particle, const double particle_energy) const
+// Method to model the measured energies of an array of detectable particles
+void SubDetector::measure_energies(const double* energies, const double* standard_normal_draws,
+  double* measured_energies, std::size_t count) const
 {
-  // Calculate energy loss in the detector based on the particle's energy
-  double energy_loss_in_detector = particle_energy * energy_loss_fraction;
-  // If the particle cannot be detected by this sub-detector, return 0 energy
-  if(!can_detect(particle)) {return 0.0;}
-  // If the detector has perfect resolution (0%), return the energy loss directly
-  if(detector_resolution == 0) {return energy_loss_in_detector;}
-  // For realistic detection, apply resolution effects by generating a distribution
-  double mean = energy_loss_in_detector;
-  double std_dev = energy_loss_in_detector * (detector_resolution / 100.0);
-  // Create a normal distribution with mean and standard deviation
-  std::normal_distribution<double> distribution(mean, std_dev);
-  // Generate a random measured energy based on the detector resolution
-  double measured_energy = distribution(const_cast<std::minstd_rand&>(random_generator));
-  // Use absolute value to ensure the measured energy is not negative
-  return std::abs(measured_energy);
-}
\ No newline at end of file
+  smear_energies(energies, standard_normal_draws, measured_energies, count, energy_loss_fraction,
+    detector_resolution);
+}
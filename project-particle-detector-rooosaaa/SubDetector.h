@@ -22,11 +22,16 @@
 #ifndef SUB_DETECTOR_H
 #define SUB_DETECTOR_H
 
+#include<cmath>
+#include<cstdint>
 #include<string>
 #include<memory>
-#include<random>
 
 #include "Particle.h"
+#include "ParticleType.h"
+#include "SubDetectorType.h"
+#include "CounterRandom.h"
+#include "DetectionCapability.h"
 
 using namespace ParticleSystem;
 using ParticleSystem::Particle;
@@ -39,20 +44,13 @@ namespace DetectorSubsystems
   protected:
     // Name of the sub-detector type (e.g., "Tracker", "Calorimeter")
     std::string sub_detector_type;
+    // Compact type code of the sub-detector, used to index fixed-size readings
+    SubDetectorType sub_detector_type_id;
     // Resolution of the sub-detector, expressed as a percentage
     // (0% = perfect, 100% = no resolution)
     int detector_resolution;
     // Fraction of energy loss in the sub-detector
     double energy_loss_fraction;
-    // Random number generator for simulating detection process
-    // 'mutable' allows this member to be modified even in a const member function.
-    // useful for generating random numbers in otherwise read-only operations.
-    mutable std::minstd_rand random_generator;
-    // Random device used to seed the random number generator
-    // Note: std::random_device is non-copyable, so it must not be copied.
-    // Therefore I'm not allowing the user to copy or move sub-detectors.
-    // It provides non-deterministic random numbers if supported by the system.
-    std::random_device random_device;
     // Helper function to validate if the particle's name is a valid string
     static bool is_valid_string_entry(const std::string& name);
 
@@ -65,6 +63,7 @@ namespace DetectorSubsystems
 
     // [GETTERS]
     std::string get_sub_detector_type() const {return sub_detector_type;}
+    SubDetectorType get_sub_detector_type_id() const {return sub_detector_type_id;}
     int get_resolution() const {return detector_resolution;}
     double get_energy_loss_fraction() const {return energy_loss_fraction;}
 
@@ -75,15 +74,65 @@ namespace DetectorSubsystems
     void set_energy_loss_fraction(double energy_loss);
     
     // [METHODS]
-    // Function to detect a particle and return its energy after detection
-    double detect_particle(const Particle& particle, const double energy) const;
+    // Function to detect a particle and return its energy after detection. The draw is keyed
+    // by (run seed, event number, particle index within the event, sub-detector), exactly as in
+    // Detector::process_batch, so the same particle gets the same reading on either path. The
+    // run seed belongs to the detector and is passed in, so both paths read it from one place
+    double detect_particle(const Particle& particle, const double energy, std::uint64_t run_seed,
+      std::uint64_t event_number, std::uint32_t particle_index) const;
+    // Function to apply energy loss and resolution smearing to an energy that is known to be
+    // detectable, given a standard normal draw. It is a pure function of its arguments and the
+    // sub-detector configuration, so it is shared by the single-particle and batch detection
+    // paths and is safe to call from several threads at once. It matches the batch kernel
+    // bit for bit only when built with -ffp-contract=off (see SmearingKernel.h).
+    double measure_energy(const double energy, const double standard_normal_draw) const;
+    // Batch version of measure_energy for arrays of detectable energies and their draws,
+    // using the vectorised smearing kernel (results are identical to measure_energy)
+    void measure_energies(const double* energies, const double* standard_normal_draws,
+      double* measured_energies, std::size_t count) const;
+    // Function to check if this sub-detector can detect a particle type without a Particle object
+    // (a single lookup in the constexpr detectability table)
+    bool can_detect_type(ParticleType type) const {
+      return (detectability_mask(type) & sub_detector_bit(sub_detector_type_id)) != 0;}
     // Pure abstract method that must be implemented in derived classes to print details of the sub-detector
     virtual void print() const = 0;
-    // Virtual method to check if this detector can detect a specific particle
-    // by calling the can_be_detected_by method in the Particle class
-    virtual bool can_detect(const Particle& particle) const {
-      return particle.can_be_detected_by(get_sub_detector_type());}
+    // Method to check if this detector can detect a specific particle
+    // by looking its type up in the detectability table
+    bool can_detect(const Particle& particle) const {return can_detect_type(particle.get_type());}
   };
+
+  // [INLINE METHODS]
+  // The per-particle detection methods are defined in the header so that they can be inlined
+  // into the unrolled sub-detector chain of StaticDetector.
+
+  // Method to detect a particle
+  inline double SubDetector::detect_particle(const Particle& particle, const double particle_energy,
+    std::uint64_t run_seed, std::uint64_t event_number, std::uint32_t particle_index) const
+  {
+    // If the particle cannot be detected by this sub-detector, return 0 energy
+    if(!can_detect(particle)) {return 0.0;}
+    // No draw is needed for perfect resolution
+    if(detector_resolution == 0) {return measure_energy(particle_energy, 0.0);}
+    const DetectorRandom::RandomStreamKey stream{run_seed, event_number, particle_index,
+      static_cast<std::uint32_t>(sub_detector_type_id)};
+    return measure_energy(particle_energy, DetectorRandom::standard_normal(stream));
+  }
+
+  // Method to model the measured energy of a detectable particle
+  inline double SubDetector::measure_energy(const double particle_energy, const double standard_normal_draw) const
+  {
+    // Calculate energy loss in the detector based on the particle's energy
+    double energy_loss_in_detector = particle_energy * energy_loss_fraction;
+    // If the detector has perfect resolution (0%), return the energy loss directly
+    if(detector_resolution == 0) {return energy_loss_in_detector;}
+    // For realistic detection, apply resolution effects as a Gaussian smearing
+    double mean = energy_loss_in_detector;
+    double std_dev = energy_loss_in_detector * (detector_resolution / 100.0);
+    // Scale the standard normal draw to the detector's mean and standard deviation
+    double measured_energy = mean + std_dev * standard_normal_draw;
+    // Use absolute value to ensure the measured energy is not negative
+    return std::abs(measured_energy);
+  }
 } // namespace DetectorSubsystems
 
 #endif // SUB_DETECTOR_H
\ No newline at end of file
@@ -0,0 +1,71 @@
+// SubDetectorType.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `SubDetectorType` enumeration, a compact integer code for each
+// of the four sub-detectors that make up a standard detector. The codes follow the order in
+// which a particle passes through the detector (Tracker first, Muon Spectrometer last), and
+// are used to index fixed-size readings instead of looking readings up by name.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef SUB_DETECTOR_TYPE_H
+#define SUB_DETECTOR_TYPE_H
+
+#include<cstddef>
+#include<cstdint>
+#include<stdexcept>
+#include<string>
+
+namespace DetectorSubsystems
+{
+  // One code per sub-detector, in detection order
+  enum class SubDetectorType : std::uint8_t
+  {
+    Tracker = 0,
+    EMCalorimeter = 1,
+    HadronicCalorimeter = 2,
+    MuonSpectrometer = 3
+  };
+
+  // Number of distinct sub-detector types, useful for sizing readings and lookup tables
+  constexpr std::size_t number_of_sub_detector_types = 4;
+
+  // Return the display name of a sub-detector type (matches SubDetector::get_sub_detector_type)
+  inline const char* sub_detector_type_name(SubDetectorType type)
+  {
+    switch(type)
+    {
+      case SubDetectorType::Tracker: return "Tracker";
+      case SubDetectorType::EMCalorimeter: return "EM Calorimeter";
+      case SubDetectorType::HadronicCalorimeter: return "Hadronic Calorimeter";
+      case SubDetectorType::MuonSpectrometer: return "Muon Spectrometer";
+    }
+    return "Unknown";
+  }
+
+  // Convert a sub-detector name into its type code; returns false for unknown names
+  inline bool find_sub_detector_type(const std::string& name, SubDetectorType& type)
+  {
+    if(name == "Tracker") {type = SubDetectorType::Tracker;}
+    else if(name == "EM Calorimeter") {type = SubDetectorType::EMCalorimeter;}
+    else if(name == "Hadronic Calorimeter") {type = SubDetectorType::HadronicCalorimeter;}
+    else if(name == "Muon Spectrometer") {type = SubDetectorType::MuonSpectrometer;}
+    else {return false;}
+    return true;
+  }
+
+  // Convert a sub-detector name into its type code; throws for unknown names
+  inline SubDetectorType sub_detector_type_from_name(const std::string& name)
+  {
+    SubDetectorType type;
+    if(!find_sub_detector_type(name, type)) {throw std::invalid_argument(
+      "Error: Unknown sub-detector type: " + name);}
+    return type;
+  }
+} // namespace DetectorSubsystems
+
+#endif // SUB_DETECTOR_TYPE_H
@@ -18,6 +18,7 @@
 #include<climits>  // For INT_MAX
 
 #include "Tracker.h"
+#include "Logging.h"
 #include "Particle.h"
 
 using namespace DetectorSubsystems;
@@ -29,7 +30,7 @@ using namespace DetectorSubsystems;
 // Sets default material to "Silicon" and assumes 3 internal subsystems.
 Tracker::Tracker() : SubDetector("Tracker", 0, 1)
 {
-  std::cout<<"Calling Tracker default constructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling Tracker default constructor.");
   set_tracker_material("Silicon");
   set_number_of_subsystems(3);
 }
@@ -37,14 +38,14 @@ Tracker::Tracker() : SubDetector("Tracker", 0, 1)
 Tracker::Tracker(int resolution, double energy_loss, const std::string& material, int number)
   : SubDetector("Tracker", resolution, energy_loss)
 {
-  // The base class constructor validates resolution and seeds the RNG
+  // The base class constructor validates resolution and seeds the random stream
   set_tracker_material(material);
   set_number_of_subsystems(number);
 }
 
 Tracker::~Tracker()
 {
-  std::cout<<"Calling Tracker destructor."<<std::endl;
+  DETECTOR_LOG_DEBUG("Calling Tracker destructor.");
 }
 
 // [SETTERS]
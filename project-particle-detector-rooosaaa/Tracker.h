@@ -31,6 +31,9 @@ namespace DetectorSubsystems
     // Any additional properties of the Tracker can be added here
 
   public:
+    // Compile-time type code of this sub-detector, used by StaticDetector
+    static constexpr SubDetectorType static_type_id = SubDetectorType::Tracker;
+
     // [RULE OF 5]
     // Default constructor
     // Sets resolution to 0 and energy loss to 1.0 (ideal, lossless tracker)
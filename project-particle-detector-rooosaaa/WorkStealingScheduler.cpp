@@ -0,0 +1,266 @@
+// WorkStealingScheduler.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Implementation file for the WorkStealingScheduler class. The deques follow the C11
+// formulation of the Chase-Lev deque by Le, Pop, Cohen and Zappa Nardelli (PPoPP 2013):
+// the owner pushes and pops at the bottom with plain loads and stores plus fences, and
+// only has to compare-and-swap the top when it pops the last range, which a thief may be
+// stealing at the same moment.
+//
+// Splitting halves a range each time, so a deque never holds more ranges than the number
+// of times the range can be halved (at most 64); the fixed capacity of 128 is never
+// reached in practice, and a worker whose deque is full simply runs the range unsplit.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<array>
+
+#include "SimdSupport.h"
+#include "WorkStealingScheduler.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include<immintrin.h>
+#endif
+
+using namespace ParticleDetector;
+
+struct WorkStealingScheduler::Worker
+{
+  static constexpr std::int64_t capacity = 128; // power of two
+  // The owner moves the bottom and thieves move the top, so they live on separate cache lines
+  alignas(DetectorSimd::cache_line_size) std::atomic<std::int64_t> top{0};
+  alignas(DetectorSimd::cache_line_size) std::atomic<std::int64_t> bottom{0};
+  // Slots are atomic because a thief may read a slot while the owner reuses it; the
+  // compare-and-swap on the top then tells the thief that its copy is stale
+  std::array<std::atomic<std::size_t>, capacity> slot_first{};
+  std::array<std::atomic<std::size_t>, capacity> slot_last{};
+  // State of the xorshift generator choosing the first worker to steal from
+  std::uint64_t random_state = 0;
+
+  // Owner only: add a range at the bottom; returns false if the deque is full
+  bool push(const Range& range)
+  {
+    const std::int64_t b = bottom.load(std::memory_order_relaxed);
+    const std::int64_t t = top.load(std::memory_order_acquire);
+    if(b - t >= capacity) {return false;}
+    slot_first[b & (capacity - 1)].store(range.first, std::memory_order_relaxed);
+    slot_last[b & (capacity - 1)].store(range.last, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return true;
+  }
+
+  // Owner only: take the most recently pushed range; returns false if the deque is empty
+  bool pop(Range& range)
+  {
+    const std::int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+    bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    std::int64_t t = top.load(std::memory_order_relaxed);
+    if(t > b)
+    {
+      // Already empty
+      bottom.store(b + 1, std::memory_order_relaxed);
+      return false;
+    }
+    range.first = slot_first[b & (capacity - 1)].load(std::memory_order_relaxed);
+    range.last = slot_last[b & (capacity - 1)].load(std::memory_order_relaxed);
+    if(t < b) {return true;} // more than one range left, so no thief can reach this one
+    // Last range: race the thieves for it
+    const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return won;
+  }
+
+  // Any thread: take the oldest (largest) range; returns false if the deque is empty or
+  // another thread took the range first
+  bool steal(Range& range)
+  {
+    std::int64_t t = top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    const std::int64_t b = bottom.load(std::memory_order_acquire);
+    if(t >= b) {return false;}
+    range.first = slot_first[t & (capacity - 1)].load(std::memory_order_relaxed);
+    range.last = slot_last[t & (capacity - 1)].load(std::memory_order_relaxed);
+    return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+  }
+};
+
+namespace
+{
+  // Wait a little longer on each failed attempt to find work: spin first, then give up the CPU
+  void back_off(unsigned int& attempt)
+  {
+    if(attempt < 64)
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      _mm_pause();
+#endif
+      ++attempt;
+    }
+    else {std::this_thread::yield();}
+  }
+}
+
+// [RULE OF 5]
+
+WorkStealingScheduler::WorkStealingScheduler(unsigned int number_of_workers) :
+  loop_generation{0}, stopping{false}, loop_task{nullptr}, loop_grain{1}, remaining_items{0},
+  cancelled{false}, number_of_steals{0}
+{
+  if(number_of_workers == 0) {number_of_workers = std::max(1u, std::thread::hardware_concurrency());}
+  for(unsigned int worker = 0; worker < number_of_workers; ++worker)
+  {
+    workers.push_back(std::make_unique<Worker>());
+    workers.back()->random_state = 0x9e3779b97f4a7c15ULL * (worker + 1);
+  }
+  threads.reserve(number_of_workers - 1);
+  try
+  {
+    for(unsigned int worker = 1; worker < number_of_workers; ++worker)
+    {
+      threads.emplace_back(&WorkStealingScheduler::worker_loop, this, worker);
+    }
+  }
+  catch(...)
+  {
+    // Do not leave the threads that did start running
+    stop_workers();
+    throw;
+  }
+}
+
+WorkStealingScheduler::~WorkStealingScheduler()
+{
+  stop_workers();
+}
+
+// [WORKERS]
+
+void WorkStealingScheduler::stop_workers()
+{
+  {
+    std::lock_guard<std::mutex> lock(loop_mutex);
+    stopping = true;
+  }
+  loop_started.notify_all();
+  for(auto& thread : threads) {thread.join();}
+  threads.clear();
+}
+
+// Function run by each worker thread: sleep until a loop is started, help until it is done
+void WorkStealingScheduler::worker_loop(std::size_t worker)
+{
+  std::uint64_t seen_generation = 0;
+  while(true)
+  {
+    {
+      std::unique_lock<std::mutex> lock(loop_mutex);
+      loop_started.wait(lock, [&] {return stopping || loop_generation != seen_generation;});
+      if(stopping) {return;}
+      seen_generation = loop_generation;
+    }
+    work_until_done(worker);
+  }
+}
+
+void WorkStealingScheduler::work_until_done(std::size_t worker)
+{
+  unsigned int attempt = 0;
+  Range range{0, 0};
+  while(remaining_items.load(std::memory_order_acquire) != 0)
+  {
+    if(workers[worker]->pop(range) || steal(worker, range))
+    {
+      run_range(worker, range);
+      attempt = 0;
+    }
+    else {back_off(attempt);}
+  }
+}
+
+// Function to steal a range, trying every other worker once starting from a random one
+bool WorkStealingScheduler::steal(std::size_t thief, Range& range)
+{
+  const std::size_t number_of_workers = workers.size();
+  if(number_of_workers < 2) {return false;}
+  std::uint64_t& state = workers[thief]->random_state;
+  state ^= state << 13;
+  state ^= state >> 7;
+  state ^= state << 17;
+  const std::size_t start = static_cast<std::size_t>(state % number_of_workers);
+  for(std::size_t offset = 0; offset < number_of_workers; ++offset)
+  {
+    const std::size_t victim = (start + offset) % number_of_workers;
+    if(victim == thief) {continue;}
+    if(workers[victim]->steal(range))
+    {
+      number_of_steals.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+  }
+  return false;
+}
+
+// Function to process a range taken from a deque:
+// - While it is larger than the grain, keep the lower half and push the upper half, which
+//   idle workers can then steal
+// - Run the task on the remaining range (skipped once the loop has been cancelled)
+// - Count its items as done; the loop ends when every item has been counted
+void WorkStealingScheduler::run_range(std::size_t worker, Range range)
+{
+  const std::size_t grain = loop_grain.load(std::memory_order_relaxed);
+  while(range.last - range.first > grain && !cancelled.load(std::memory_order_relaxed))
+  {
+    const std::size_t middle = range.first + (range.last - range.first) / 2;
+    if(!workers[worker]->push(Range{middle, range.last})) {break;}
+    range.last = middle;
+  }
+  if(!cancelled.load(std::memory_order_relaxed))
+  {
+    try {(*loop_task.load(std::memory_order_relaxed))(range.first, range.last);}
+    catch(...)
+    {
+      std::lock_guard<std::mutex> lock(error_mutex);
+      if(!first_error) {first_error = std::current_exception();}
+      cancelled.store(true, std::memory_order_relaxed);
+    }
+  }
+  remaining_items.fetch_sub(range.last - range.first, std::memory_order_acq_rel);
+}
+
+// [METHODS]
+
+void WorkStealingScheduler::parallel_for(std::size_t first, std::size_t last, std::size_t grain,
+  const RangeTask& task)
+{
+  if(first >= last) {return;}
+  std::lock_guard<std::mutex> parallel_for_lock(parallel_for_mutex);
+  first_error = nullptr;
+  cancelled.store(false, std::memory_order_relaxed);
+  loop_task.store(&task, std::memory_order_relaxed);
+  loop_grain.store(std::max<std::size_t>(1, grain), std::memory_order_relaxed);
+  remaining_items.store(last - first, std::memory_order_release);
+  // The whole range starts on the calling thread's deque; the other workers steal from it
+  workers[0]->push(Range{first, last});
+  if(!threads.empty())
+  {
+    {
+      std::lock_guard<std::mutex> lock(loop_mutex);
+      ++loop_generation;
+    }
+    loop_started.notify_all();
+  }
+  work_until_done(0);
+  if(first_error)
+  {
+    std::exception_ptr error = first_error;
+    first_error = nullptr;
+    std::rethrow_exception(error);
+  }
+}
@@ -0,0 +1,117 @@
+// WorkStealingScheduler.h
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// This header file defines the `WorkStealingScheduler` class, a pool of worker threads that
+// runs a parallel loop over a range of items (e.g. the particles of a batch) so that every
+// core stays busy until the loop is done, however unevenly the work is spread over the range.
+//
+// Every worker owns a double-ended queue (deque) of sub-ranges. A worker takes the range it
+// works on from the bottom of its own deque, and while the range is larger than the grain
+// size it splits it in half, pushes the upper half back onto its deque and carries on with
+// the lower half. A worker whose deque is empty steals from the top of another worker's
+// deque, which holds the largest range that worker has not started yet. Only the owner
+// touches the bottom of a deque, so pushing and popping need no lock; a steal is a single
+// compare-and-swap (the deque of Chase and Lev).
+//
+// The calling thread takes part as worker 0, so a scheduler with one worker runs the loop
+// on the calling thread without starting any threads. The worker threads are started once,
+// sleep between loops and are reused by every call to parallel_for.
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#ifndef WORK_STEALING_SCHEDULER_H
+#define WORK_STEALING_SCHEDULER_H
+
+#include<atomic>
+#include<condition_variable>
+#include<cstddef>
+#include<cstdint>
+#include<exception>
+#include<functional>
+#include<memory>
+#include<mutex>
+#include<thread>
+#include<vector>
+
+namespace ParticleDetector
+{
+  class WorkStealingScheduler
+  {
+  public:
+    // Process the items [first, last) of the loop
+    using RangeTask = std::function<void(std::size_t first, std::size_t last)>;
+
+  private:
+    // Deque and random state of one worker (defined in WorkStealingScheduler.cpp)
+    struct Worker;
+    struct Range
+    {
+      std::size_t first;
+      std::size_t last;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers; // worker 0 is the thread calling parallel_for
+    std::vector<std::thread> threads; // threads of workers 1 and above
+
+    // Current loop, published to the worker threads under loop_mutex
+    std::mutex loop_mutex;
+    std::condition_variable loop_started;
+    std::uint64_t loop_generation;
+    bool stopping;
+    std::atomic<const RangeTask*> loop_task;
+    std::atomic<std::size_t> loop_grain;
+    // Items of the current loop not processed yet; the loop is done when this reaches 0
+    std::atomic<std::size_t> remaining_items;
+    // First error raised by the task; the rest of the loop is skipped once it is set
+    std::mutex error_mutex;
+    std::exception_ptr first_error;
+    std::atomic<bool> cancelled;
+    // Only one parallel_for runs at a time
+    std::mutex parallel_for_mutex;
+    std::atomic<std::uint64_t> number_of_steals;
+
+    void worker_loop(std::size_t worker);
+    // Wake the worker threads, tell them to return and join them
+    void stop_workers();
+    // Take or steal ranges until every item of the current loop has been processed
+    void work_until_done(std::size_t worker);
+    bool steal(std::size_t thief, Range& range);
+    // Split a range down to the grain size, then run the task on what is left
+    void run_range(std::size_t worker, Range range);
+
+  public:
+    // [RULE OF 5]
+    // Parameterised constructor, with the given number of workers including the calling thread
+    // (0 = one per hardware thread)
+    explicit WorkStealingScheduler(unsigned int number_of_workers = 0);
+    // Not allowing copy or move operations as the worker threads refer to the scheduler
+    // Copy constructor
+    WorkStealingScheduler(const WorkStealingScheduler& other) = delete;
+    // Move constructor
+    WorkStealingScheduler(WorkStealingScheduler&& other) = delete;
+    // Copy assignment operator
+    WorkStealingScheduler& operator=(const WorkStealingScheduler& other) = delete;
+    // Move assignment operator
+    WorkStealingScheduler& operator=(WorkStealingScheduler&& other) = delete;
+    // Destructor, stops and joins the worker threads
+    ~WorkStealingScheduler();
+
+    // [GETTERS]
+    unsigned int get_number_of_workers() const {return static_cast<unsigned int>(workers.size());}
+    // Ranges taken from another worker's deque since the scheduler was created
+    std::uint64_t get_number_of_steals() const {return number_of_steals.load(std::memory_order_relaxed);}
+
+    // [METHODS]
+    // Run task over [first, last) in ranges of at most `grain` items (at least 1) and return
+    // when every item has been processed. Ranges run concurrently, so the task must only
+    // write to data belonging to its own range. If the task throws, the remaining ranges
+    // are skipped and the first exception is rethrown.
+    void parallel_for(std::size_t first, std::size_t last, std::size_t grain, const RangeTask& task);
+  };
+} // namespace ParticleDetector
+
+#endif // WORK_STEALING_SCHEDULER_H
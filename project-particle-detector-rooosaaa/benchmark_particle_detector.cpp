@@ -0,0 +1,721 @@
+// benchmark_particle_detector.cpp
+// PHYS30762 - Project: Particle Detector
+// Author: Rosa Roberts
+// Date: 11-05-2025
+//
+// Benchmark program for the Particle Detector project. It times the main building blocks
+// of the simulation and whole events, so runs before and after a change can be compared:
+// - micro benchmarks over 1024 particles: FourMomentum kinematics (per particle and with the
+//   batch kinematics kernel), SubDetector::detect_particle for each sub-detector and
+//   Detector::identify_particle
+// - event benchmarks at several multiplicities (particles per event): calculate_invariant_mass,
+//   calculate_missing_energy, and the full event through the object path (pools, arena,
+//   detect_particle, identification, MET and mass), the batch path (process_batch,
+//   identify_batch and summarise_batch) and the batch path through StaticDetector, which is
+//   first checked to give the same readings as Detector for ATLAS and CMS (this needs the
+//   -ffp-contract=off of the bench target; see SmearingKernel.h)
+// - a mixed batch of two-particle and pileup events through process_batch, with a scheduler
+//   started per batch and with one reused for every batch
+// - phase-space generation of H, Z and top quark decays straight into a batch
+//
+// Each benchmark reports ns per iteration, ns per particle, events per second and the number
+// of heap allocations (and bytes) per iteration, counted by replacing the global operator
+// new of this program. Times are the median of several repetitions after a warm-up run.
+// Results are printed as a table, or as JSON or CSV for scripts comparing runs.
+//
+// Usage: benchmark_particle_detector.out [--format=table|json|csv] [--output=FILE]
+//          [--min-time=SECONDS] [--filter=TEXT] [--multiplicities=2,10,100,1000]
+//
+// === COMPILATION AND EXECUTION ===
+//
+// Please see the README file for details on compilation and execution of this program.
+
+#include<algorithm>
+#include<atomic>
+#include<chrono>
+#include<cmath>
+#include<cstdint>
+#include<cstdlib>
+#include<fstream>
+#include<iomanip>
+#include<iostream>
+#include<memory_resource>
+#include<new>
+#include<sstream>
+#include<stdexcept>
+#include<streambuf>
+#include<string>
+#include<thread>
+#include<vector>
+
+#include "FourMomentum.h"
+#include "Particle.h"
+#include "Electron.h"
+#include "Neutrino.h"
+#include "Photon.h"
+#include "Muon.h"
+#include "Hadron.h"
+#include "Positron.h"
+#include "Detector.h"
+#include "EventArena.h"
+#include "ParticlePool.h"
+#include "ParticleBatch.h"
+#include "KinematicsKernel.h"
+#include "MissingEnergyAccumulator.h"
+#include "CounterRandom.h"
+#include "Logging.h"
+#include "SimdSupport.h"
+#include "StaticDetector.h"
+#include "WorkStealingScheduler.h"
+#include "PhaseSpaceGenerator.h"
+
+using namespace ParticleDetector;
+using ParticleSystem::EventArena;
+using ParticleSystem::Particle;
+using ParticleSystem::ParticleBatch;
+using ParticleSystem::ParticleList;
+using ParticleSystem::ParticlePools;
+using ParticleSystem::ParticleType;
+
+// [ALLOCATION COUNTING]
+// Every heap allocation of the program goes through these replacements of the global
+// operator new, so a benchmark can read how many allocations its iterations made.
+
+namespace
+{
+  std::atomic<std::uint64_t> allocation_count{0};
+  std::atomic<std::uint64_t> allocated_bytes{0};
+
+  void* counted_allocation(std::size_t size, std::size_t alignment)
+  {
+    allocation_count.fetch_add(1, std::memory_order_relaxed);
+    allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+    if(size == 0) {size = 1;}
+    void* memory = alignment <= alignof(std::max_align_t) ? std::malloc(size) :
+      std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+    if(memory == nullptr) {throw std::bad_alloc();}
+    return memory;
+  }
+}
+
+void* operator new(std::size_t size) {return counted_allocation(size, 0);}
+void* operator new[](std::size_t size) {return counted_allocation(size, 0);}
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+void* operator new[](std::size_t size, std::align_val_t alignment)
+{
+  return counted_allocation(size, static_cast<std::size_t>(alignment));
+}
+void operator delete(void* memory) noexcept {std::free(memory);}
+void operator delete[](void* memory) noexcept {std::free(memory);}
+void operator delete(void* memory, std::size_t) noexcept {std::free(memory);}
+void operator delete[](void* memory, std::size_t) noexcept {std::free(memory);}
+void operator delete(void* memory, std::align_val_t) noexcept {std::free(memory);}
+void operator delete[](void* memory, std::align_val_t) noexcept {std::free(memory);}
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {std::free(memory);}
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {std::free(memory);}
+
+namespace
+{
+  // [HARNESS]
+
+  // Keep a value alive so the compiler cannot remove the computation that produced it
+  template<typename T> inline void keep(const T& value)
+  {
+    asm volatile("" : : "g"(&value) : "memory");
+  }
+
+  // Stream buffer that discards everything, used while timing functions that print
+  class NullBuffer : public std::streambuf
+  {
+  protected:
+    int overflow(int character) override {return character;}
+    std::streamsize xsputn(const char*, std::streamsize count) override {return count;}
+  };
+
+  // Redirects std::cout to a NullBuffer for the lifetime of the object
+  class SilencedOutput
+  {
+  private:
+    NullBuffer null_buffer;
+    std::streambuf* previous;
+
+  public:
+    SilencedOutput() : previous{std::cout.rdbuf(&null_buffer)} {}
+    SilencedOutput(const SilencedOutput& other) = delete;
+    SilencedOutput& operator=(const SilencedOutput& other) = delete;
+    ~SilencedOutput() {std::cout.rdbuf(previous);}
+  };
+
+  enum class OutputFormat {Table, Json, Csv};
+
+  struct BenchmarkOptions
+  {
+    OutputFormat format = OutputFormat::Table;
+    std::string output_file; // empty for standard output
+    double min_time = 0.2; // seconds of timed iterations per benchmark
+    int repetitions = 5;
+    std::string filter; // only run benchmarks whose name contains this text
+    std::vector<std::size_t> multiplicities{2, 10, 100, 1000};
+  };
+
+  struct BenchmarkResult
+  {
+    std::string name;
+    std::size_t multiplicity; // particles per event (0 for micro benchmarks)
+    std::uint64_t iterations; // timed iterations over all repetitions
+    double ns_per_iteration; // median over the repetitions
+    double ns_per_particle;
+    double events_per_second; // 0 for micro benchmarks
+    double allocations_per_iteration;
+    double bytes_per_iteration;
+  };
+
+  // Time `body(iterations)`, which must run its work `iterations` times:
+  // - one warm-up call (fills caches, pools and arenas)
+  // - the iteration count is doubled until one repetition takes min_time / repetitions
+  // - the median time per iteration over the repetitions is reported
+  template<typename Body>
+  void run_benchmark(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results, const std::string& name,
+    std::size_t multiplicity, std::size_t particles_per_iteration, std::size_t events_per_iteration, Body&& body)
+  {
+    if(!options.filter.empty() && name.find(options.filter) == std::string::npos) {return;}
+    using Clock = std::chrono::steady_clock;
+    auto time_iterations = [&](std::uint64_t iterations)
+    {
+      const auto start = Clock::now();
+      body(iterations);
+      return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+    time_iterations(1);
+    const double target = options.min_time / options.repetitions;
+    std::uint64_t iterations = 1;
+    while(time_iterations(iterations) < target && iterations < (std::uint64_t(1) << 40)) {iterations *= 2;}
+    std::vector<double> ns_per_iteration;
+    ns_per_iteration.reserve(options.repetitions);
+    const std::uint64_t allocations_before = allocation_count.load();
+    const std::uint64_t bytes_before = allocated_bytes.load();
+    for(int repetition = 0; repetition < options.repetitions; ++repetition)
+    {
+      ns_per_iteration.push_back(time_iterations(iterations) * 1e9 / static_cast<double>(iterations));
+    }
+    const double total_iterations = static_cast<double>(iterations) * options.repetitions;
+    const double allocations = static_cast<double>(allocation_count.load() - allocations_before);
+    const double bytes = static_cast<double>(allocated_bytes.load() - bytes_before);
+    std::sort(ns_per_iteration.begin(), ns_per_iteration.end());
+    const double median = ns_per_iteration[ns_per_iteration.size() / 2];
+    results.push_back(BenchmarkResult{name, multiplicity, iterations * options.repetitions, median,
+      particles_per_iteration > 0 ? median / static_cast<double>(particles_per_iteration) : 0.0,
+      events_per_iteration > 0 ? 1e9 * static_cast<double>(events_per_iteration) / median : 0.0,
+      allocations / total_iterations, bytes / total_iterations});
+  }
+
+  // [EVENT GENERATION]
+
+  // Momentum and type of one generated particle
+  struct ParticleSpec
+  {
+    ParticleType type;
+    double charge;
+    FourMomentum momentum;
+  };
+
+  // Reproducible random particles of every type, with momenta of up to 100 GeV per component
+  std::vector<ParticleSpec> generate_particles(std::size_t count, std::uint64_t seed)
+  {
+    std::vector<ParticleSpec> particles;
+    particles.reserve(count);
+    for(std::size_t i = 0; i < count; ++i)
+    {
+      // Two counter-based random blocks per particle (see CounterRandom.h)
+      const auto first = DetectorRandom::random_block({seed, i, 0, 0});
+      const auto second = DetectorRandom::random_block({seed, i, 1, 0});
+      const auto type = static_cast<ParticleType>(first[0] % ParticleSystem::number_of_particle_types);
+      const double px = 200.0 * DetectorRandom::uniform_open_closed(first[1], first[2]) - 100.0;
+      const double py = 200.0 * DetectorRandom::uniform_open_closed(first[3], second[0]) - 100.0;
+      const double pz = 200.0 * DetectorRandom::uniform_open_closed(second[1], second[2]) - 100.0;
+      const double mass = (type == ParticleType::Photon || type == ParticleType::Neutrino) ? 0.0 : 0.14;
+      const double energy = std::sqrt(px * px + py * py + pz * pz + mass * mass) * (1.0 + 1e-12);
+      double charge = 0.0;
+      if(type == ParticleType::Electron || type == ParticleType::Muon) {charge = -1.0;}
+      else if(type == ParticleType::Positron || type == ParticleType::Hadron) {charge = 1.0;}
+      particles.push_back(ParticleSpec{type, charge, FourMomentum(px, py, pz, energy)});
+    }
+    return particles;
+  }
+
+  // Make the particle object of a generated particle from the pools
+  ParticleSystem::ParticlePtr make_particle(ParticlePools& pools, const ParticleSpec& spec)
+  {
+    switch(spec.type)
+    {
+      case ParticleType::Electron: return pools.make_particle<Electron>(1, spec.momentum);
+      case ParticleType::Positron: return pools.make_particle<Positron>(1, spec.momentum);
+      case ParticleType::Muon: return pools.make_particle<Muon>(1, spec.momentum);
+      case ParticleType::Photon: return pools.make_particle<Photon>(1, spec.momentum);
+      case ParticleType::Hadron: return pools.make_particle<Hadron>(1, spec.momentum, "pion", spec.charge);
+      case ParticleType::Neutrino: return pools.make_particle<Neutrino>(1, spec.momentum);
+    }
+    throw std::logic_error("Error: Unknown particle type.");
+  }
+
+  // [MICRO BENCHMARKS]
+
+  void run_micro_benchmarks(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+  {
+    constexpr std::size_t count = 1024;
+    const auto specs = generate_particles(count, 1);
+    std::vector<FourMomentum> momenta;
+    std::vector<double> px, py, pz, energy;
+    for(const auto& spec : specs)
+    {
+      momenta.push_back(spec.momentum);
+      px.push_back(spec.momentum.get_px());
+      py.push_back(spec.momentum.get_py());
+      pz.push_back(spec.momentum.get_pz());
+      energy.push_back(spec.momentum.get_energy());
+    }
+
+    run_benchmark(options, results, "four_momentum_kinematics", 0, count, 0, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        for(const auto& momentum : momenta)
+        {
+          double sum = momentum.calculate_invariant_mass() + momentum.calculate_transverse_momentum() +
+            momentum.calculate_pseudorapidity() + momentum.calculate_azimuthal_angle();
+          keep(sum);
+        }
+      }
+    });
+
+    std::vector<double> columns(5 * count);
+    ParticleProperties::KinematicsOutput output{columns.data(), columns.data() + count, columns.data() + 2 * count,
+      columns.data() + 3 * count, columns.data() + 4 * count};
+    run_benchmark(options, results, "batch_kinematics_kernel", 0, count, 0, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        ParticleProperties::compute_kinematics(px.data(), py.data(), pz.data(), energy.data(), count, output);
+        keep(columns[0]);
+      }
+    });
+
+    ParticlePools pools;
+    std::vector<ParticleSystem::ParticlePtr> particles;
+    for(const auto& spec : specs) {particles.push_back(make_particle(pools, spec));}
+    Detector detector("ATLAS");
+    for(const auto& sub_detector : detector.get_subdetectors())
+    {
+      std::string name = "sub_detector_detect_particle/" + sub_detector->get_sub_detector_type();
+      std::replace(name.begin(), name.end(), ' ', '_');
+      run_benchmark(options, results, name, 0, count, 0, [&](std::uint64_t iterations)
+      {
+        for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          for(std::size_t i = 0; i < particles.size(); ++i)
+          {
+            double measured = sub_detector->detect_particle(*particles[i], particles[i]->get_momentum().get_energy(),
+              detector.get_run_seed(), iteration, static_cast<std::uint32_t>(i));
+            keep(measured);
+          }
+        }
+      });
+    }
+
+    std::vector<DetectorReadings> readings;
+    detector.set_detector_status(true);
+    for(std::size_t i = 0; i < particles.size(); ++i)
+    {
+      readings.push_back(detector.detect_particle(*particles[i], 0, static_cast<std::uint32_t>(i)));
+    }
+    run_benchmark(options, results, "detector_identify_particle", 0, count, 0, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        for(const auto& reading : readings)
+        {
+          IdentifiedParticle identified = Detector::identify_particle(reading);
+          keep(identified);
+        }
+      }
+    });
+  }
+
+  // [EVENT BENCHMARKS]
+
+  // Check that a StandardStaticDetector gives bit-identical readings to the Detector of the
+  // same name, on the batch path and (for every particle of the first event) on the object
+  // path; throws if any reading differs, so a broken template (or a build without
+  // -ffp-contract=off, where the two paths round differently) does not produce timings
+  template<typename Config>
+  void check_static_detector(const std::string& detector_name, const ParticleBatch& batch, ParticlePools& pools,
+    const std::vector<ParticleSpec>& specs)
+  {
+    Detector detector(detector_name);
+    detector.set_detector_status(true);
+    StandardStaticDetector<Config> static_detector;
+    static_detector.set_detector_status(true);
+    ReadingsBatch expected, readings;
+    detector.process_batch(batch, expected, 1);
+    static_detector.process_batch(batch.view(), readings);
+    for(std::size_t type = 0; type < DetectorSubsystems::number_of_sub_detector_types; ++type)
+    {
+      if(readings.energy_columns[type] != expected.energy_columns[type]) {throw std::runtime_error(
+        "StaticDetector batch readings differ from Detector for " + detector_name);}
+    }
+    const std::size_t first_event_size = std::min(specs.size(), static_cast<std::size_t>(batch.event_offsets[1]));
+    for(std::size_t i = 0; i < first_event_size; ++i)
+    {
+      const auto particle = make_particle(pools, specs[i]);
+      const DetectorReadings reading = static_detector.detect_particle(*particle, batch.first_event_number,
+        static_cast<std::uint32_t>(i));
+      const DetectorReadings expected_reading = detector.detect_particle(*particle, batch.first_event_number,
+        static_cast<std::uint32_t>(i));
+      for(std::size_t type = 0; type < DetectorSubsystems::number_of_sub_detector_types; ++type)
+      {
+        const auto sub_detector_type = static_cast<DetectorSubsystems::SubDetectorType>(type);
+        if(reading[sub_detector_type] != expected_reading[sub_detector_type] ||
+          reading[sub_detector_type] != expected.energy_columns[type][i])
+        {
+          throw std::runtime_error("StaticDetector particle readings differ from Detector for " + detector_name);
+        }
+      }
+    }
+  }
+
+  void run_event_benchmarks(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results,
+    std::size_t multiplicity)
+  {
+    const auto specs = generate_particles(multiplicity, 1);
+    Detector detector("ATLAS");
+    detector.set_detector_status(true);
+    ParticlePools pools;
+    EventArena arena;
+    // Functions that print are timed with their output discarded
+    SilencedOutput silenced;
+
+    {
+      ParticleList particles(std::pmr::new_delete_resource());
+      std::pmr::vector<DetectorReadings> readings(std::pmr::new_delete_resource());
+      for(const auto& spec : specs)
+      {
+        particles.push_back(make_particle(pools, spec));
+        readings.push_back(detector.detect_particle(*particles.back(), 0,
+          static_cast<std::uint32_t>(particles.size() - 1)));
+      }
+      run_benchmark(options, results, "calculate_invariant_mass", multiplicity, multiplicity, 1,
+        [&](std::uint64_t iterations)
+      {
+        for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          double mass = detector.calculate_invariant_mass(particles, "Benchmark", "Higgs boson",
+            arena.get_resource());
+          keep(mass);
+          arena.reset();
+        }
+      });
+      run_benchmark(options, results, "calculate_missing_energy", multiplicity, multiplicity, 1,
+        [&](std::uint64_t iterations)
+      {
+        for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          double met = detector.calculate_missing_energy(particles, readings, "Benchmark");
+          keep(met);
+        }
+      });
+    }
+
+    // Full event through the particle objects, as in the main program
+    run_benchmark(options, results, "event_object_path", multiplicity, multiplicity, 1, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        {
+          ParticleList particles = arena.make_particle_list();
+          particles.reserve(specs.size());
+          for(const auto& spec : specs) {particles.push_back(make_particle(pools, spec));}
+          MissingEnergyAccumulator missing_energy;
+          for(std::size_t i = 0; i < particles.size(); ++i)
+          {
+            const DetectorReadings reading = detector.detect_particle(*particles[i], iteration,
+              static_cast<std::uint32_t>(i));
+            IdentifiedParticle identified = Detector::identify_particle(reading);
+            keep(identified);
+            missing_energy.add_particle(*particles[i], reading);
+          }
+          double mass = particles.size() >= 2 ?
+            detector.calculate_invariant_mass(particles, "Benchmark", "Higgs boson",
+              arena.get_resource()) : 0.0;
+          double met = detector.calculate_missing_energy(missing_energy, "Benchmark");
+          keep(mass);
+          keep(met);
+        }
+        arena.reset();
+      }
+    });
+
+    // Full events through the columnar batch path, with several events per batch
+    const std::size_t events_per_batch = std::max<std::size_t>(1, 4096 / multiplicity);
+    ParticleBatch batch;
+    batch.reserve(events_per_batch, events_per_batch * multiplicity);
+    for(std::size_t event = 0; event < events_per_batch; ++event)
+    {
+      for(const auto& spec : specs)
+      {
+        batch.add_particle(spec.type, spec.charge, spec.momentum.get_px(), spec.momentum.get_py(),
+          spec.momentum.get_pz(), spec.momentum.get_energy());
+      }
+      batch.end_event();
+    }
+    ReadingsBatch readings;
+    std::vector<IdentifiedParticle> identified;
+    EventSummaryBatch summaries;
+    std::vector<unsigned int> thread_counts{1};
+    if(std::thread::hardware_concurrency() > 1) {thread_counts.push_back(std::thread::hardware_concurrency());}
+    for(const unsigned int threads : thread_counts)
+    {
+      run_benchmark(options, results, "event_batch_path/threads=" + std::to_string(threads), multiplicity,
+        events_per_batch * multiplicity, events_per_batch, [&](std::uint64_t iterations)
+      {
+        for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+        {
+          detector.process_batch(batch, readings, threads);
+          Detector::identify_batch(readings, identified);
+          detector.summarise_batch(batch.view(), readings, summaries);
+          keep(summaries.detected_met[0]);
+        }
+      });
+    }
+
+    // The same batch through the compile-time StaticDetector (single thread), after checking
+    // that it matches Detector for both detector configurations
+    check_static_detector<ATLASConfig>("ATLAS", batch, pools, specs);
+    check_static_detector<CMSConfig>("CMS", batch, pools, specs);
+    StandardStaticDetector<ATLASConfig> static_detector;
+    static_detector.set_detector_status(true);
+    run_benchmark(options, results, "event_static_detector/threads=1", multiplicity,
+      events_per_batch * multiplicity, events_per_batch, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        static_detector.process_batch(batch.view(), readings);
+        Detector::identify_batch(readings, identified);
+        detector.summarise_batch(batch.view(), readings, summaries);
+        keep(summaries.detected_met[0]);
+      }
+    });
+  }
+
+  // Batch of mostly two-particle events followed by a few pileup events of thousands of
+  // particles, the case where splitting a batch into equal numbers of events leaves most
+  // threads idle while one works through the pileup events
+  void run_mixed_multiplicity_benchmarks(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+  {
+    constexpr std::size_t small_events = 4096;
+    constexpr std::size_t pileup_events = 4;
+    constexpr std::size_t pileup_multiplicity = 4096;
+    const auto specs = generate_particles(pileup_multiplicity, 2);
+    Detector detector("ATLAS");
+    detector.set_detector_status(true);
+    ParticleBatch batch;
+    batch.reserve(small_events + pileup_events, 2 * small_events + pileup_events * pileup_multiplicity);
+    auto add_event = [&](std::size_t multiplicity, std::size_t first_spec)
+    {
+      for(std::size_t i = 0; i < multiplicity; ++i)
+      {
+        const auto& spec = specs[(first_spec + i) % specs.size()];
+        batch.add_particle(spec.type, spec.charge, spec.momentum.get_px(), spec.momentum.get_py(),
+          spec.momentum.get_pz(), spec.momentum.get_energy());
+      }
+      batch.end_event();
+    };
+    for(std::size_t event = 0; event < small_events; ++event) {add_event(2, 2 * event);}
+    for(std::size_t event = 0; event < pileup_events; ++event) {add_event(pileup_multiplicity, 0);}
+    const std::size_t number_of_particles = batch.number_of_particles();
+    const std::size_t number_of_events = batch.number_of_events();
+    ReadingsBatch readings;
+    const unsigned int threads = std::max(1u, std::thread::hardware_concurrency());
+    run_benchmark(options, results, "mixed_batch/threads=" + std::to_string(threads),
+      number_of_particles / number_of_events, number_of_particles, number_of_events, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        detector.process_batch(batch, readings, threads);
+        keep(readings.energy_columns[0][0]);
+      }
+    });
+    // The same with one scheduler kept for every batch, so no threads are started per batch
+    WorkStealingScheduler scheduler(threads);
+    run_benchmark(options, results, "mixed_batch/scheduler=" + std::to_string(threads),
+      number_of_particles / number_of_events, number_of_particles, number_of_events, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        detector.process_batch(batch, readings, scheduler);
+        keep(readings.energy_columns[0][0]);
+      }
+    });
+  }
+
+  // Generation of 1000 phase-space decays into a batch that is cleared and reused, so after
+  // the first iteration no memory is allocated
+  void run_generator_benchmarks(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results)
+  {
+    constexpr std::size_t number_of_events = 1000;
+    const ParticleSystem::PhaseSpaceGenerator generator;
+    ParticleBatch batch;
+    generator.generate(batch, number_of_events);
+    const std::size_t number_of_particles = batch.number_of_particles();
+    run_benchmark(options, results, "phase_space/generate", number_of_particles / number_of_events,
+      number_of_particles, number_of_events, [&](std::uint64_t iterations)
+    {
+      for(std::uint64_t iteration = 0; iteration < iterations; ++iteration)
+      {
+        batch.clear();
+        batch.first_event_number = iteration * number_of_events;
+        generator.generate(batch, number_of_events);
+        keep(batch.energy[0]);
+      }
+    });
+  }
+
+  // [OUTPUT]
+
+  std::string json_string(const std::string& text)
+  {
+    std::string quoted = "\"";
+    for(const char character : text)
+    {
+      if(character == '"' || character == '\\') {quoted += '\\';}
+      quoted += character;
+    }
+    return quoted + "\"";
+  }
+
+  void write_results(const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options,
+    std::ostream& output)
+  {
+    const char* simd_level = DetectorSimd::simd_level_name(DetectorSimd::active_simd_level());
+    const unsigned int hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    output<<std::setprecision(6);
+    if(options.format == OutputFormat::Json)
+    {
+      output<<"{\n  \"benchmark\": \"particle_detector\",\n  \"simd_level\": "<<json_string(simd_level)
+        <<",\n  \"hardware_threads\": "<<hardware_threads<<",\n  \"results\": ["<<std::endl;
+      for(std::size_t i = 0; i < results.size(); ++i)
+      {
+        const auto& result = results[i];
+        output<<"    {\"name\": "<<json_string(result.name)<<", \"multiplicity\": "<<result.multiplicity
+          <<", \"iterations\": "<<result.iterations<<", \"ns_per_iteration\": "<<result.ns_per_iteration
+          <<", \"ns_per_particle\": "<<result.ns_per_particle<<", \"events_per_second\": "<<result.events_per_second
+          <<", \"allocations_per_iteration\": "<<result.allocations_per_iteration<<", \"bytes_per_iteration\": "
+          <<result.bytes_per_iteration<<"}"<<(i + 1 < results.size() ? "," : "")<<std::endl;
+      }
+      output<<"  ]\n}"<<std::endl;
+    }
+    else if(options.format == OutputFormat::Csv)
+    {
+      output<<"name,multiplicity,iterations,ns_per_iteration,ns_per_particle,events_per_second,"
+        "allocations_per_iteration,bytes_per_iteration"<<std::endl;
+      for(const auto& result : results)
+      {
+        output<<result.name<<","<<result.multiplicity<<","<<result.iterations<<","<<result.ns_per_iteration<<","
+          <<result.ns_per_particle<<","<<result.events_per_second<<","<<result.allocations_per_iteration<<","
+          <<result.bytes_per_iteration<<std::endl;
+      }
+    }
+    else
+    {
+      output<<"Particle Detector benchmarks (SIMD level: "<<simd_level<<", hardware threads: "<<hardware_threads
+        <<")\n"<<std::endl;
+      output<<std::left<<std::setw(52)<<"Benchmark"<<std::right<<std::setw(8)<<"Mult."<<std::setw(16)<<"ns/iter"
+        <<std::setw(12)<<"ns/particle"<<std::setw(14)<<"events/s"<<std::setw(12)<<"allocs/iter"<<std::endl;
+      output<<std::fixed;
+      for(const auto& result : results)
+      {
+        output<<std::left<<std::setw(52)<<result.name<<std::right<<std::setw(8)<<result.multiplicity
+          <<std::setprecision(1)<<std::setw(16)<<result.ns_per_iteration<<std::setprecision(2)<<std::setw(12)
+          <<result.ns_per_particle<<std::setprecision(0)<<std::setw(14)<<result.events_per_second
+          <<std::setprecision(2)<<std::setw(12)<<result.allocations_per_iteration<<std::endl;
+      }
+    }
+  }
+
+  // [COMMAND LINE]
+
+  BenchmarkOptions parse_options(int argc, char* argv[])
+  {
+    BenchmarkOptions options;
+    for(int i = 1; i < argc; ++i)
+    {
+      const std::string argument = argv[i];
+      const std::size_t equals = argument.find('=');
+      const std::string key = argument.substr(0, equals);
+      const std::string value = equals == std::string::npos ? "" : argument.substr(equals + 1);
+      if(key == "--format")
+      {
+        if(value == "table") {options.format = OutputFormat::Table;}
+        else if(value == "json") {options.format = OutputFormat::Json;}
+        else if(value == "csv") {options.format = OutputFormat::Csv;}
+        else {throw std::invalid_argument("Unknown output format: " + value);}
+      }
+      else if(key == "--output") {options.output_file = value;}
+      else if(key == "--min-time")
+      {
+        options.min_time = std::stod(value);
+        if(!(options.min_time > 0.0)) {throw std::invalid_argument("--min-time must be positive.");}
+      }
+      else if(key == "--filter") {options.filter = value;}
+      else if(key == "--multiplicities")
+      {
+        options.multiplicities.clear();
+        std::istringstream list(value);
+        for(std::string entry; std::getline(list, entry, ',');)
+        {
+          const unsigned long multiplicity = std::stoul(entry);
+          if(multiplicity == 0) {throw std::invalid_argument("Multiplicities must be positive.");}
+          options.multiplicities.push_back(multiplicity);
+        }
+      }
+      else {throw std::invalid_argument("Unknown option: " + argument);}
+    }
+    return options;
+  }
+}
+
+// Main function
+// - Runs the micro benchmarks, then the event benchmarks at each multiplicity
+// - Writes the results in the requested format to standard output or to --output
+int main(int argc, char* argv[])
+{
+  try
+  {
+    const BenchmarkOptions options = parse_options(argc, argv);
+    // Constructor and status messages would dominate the timings
+    DetectorLogging::set_log_level(DetectorLogging::LogLevel::None);
+    std::vector<BenchmarkResult> results;
+    run_micro_benchmarks(options, results);
+    for(const std::size_t multiplicity : options.multiplicities)
+    {
+      run_event_benchmarks(options, results, multiplicity);
+    }
+    run_mixed_multiplicity_benchmarks(options, results);
+    run_generator_benchmarks(options, results);
+    if(options.output_file.empty()) {write_results(results, options, std::cout);}
+    else
+    {
+      std::ofstream output(options.output_file);
+      if(!output) {throw std::runtime_error("Cannot open output file: " + options.output_file);}
+      write_results(results, options, output);
+    }
+  }
+  catch(const std::exception& e)
+  {
+    std::cerr<<"Error: "<<e.what()<<std::endl;
+    return -1;
+  }
+  return 0;
+}
@@ -18,7 +18,21 @@
 //
 // Please see the README file for details on compilation and execution of this program.
 
+#include<algorithm>
+#include<array>
+#include<atomic>
+#include<charconv>
+#include<cstdint>
+#include<fstream>
+#include<functional>
 #include<iostream>
+#include<memory>
+#include<memory_resource>
+#include<mutex>
+#include<stdexcept>
+#include<string>
+#include<thread>
+#include<utility>
 #include<vector>
 
 #include "FourMomentum.h"
@@ -39,80 +53,152 @@
 #include "Detector.h"
 
 #include "DetectorConfig.h"
+#include "EventArena.h"
+#include "ParticlePool.h"
+#include "LheReader.h"
+#include "AnalysisHistograms.h"
+#include "ColumnarOutputWriter.h"
+#include "EventPipeline.h"
+#include "EventFileReader.h"
+#include "EventFileWriter.h"
+#include "Generator.h"
+#include "PhaseSpaceGenerator.h"
+#include "MissingEnergyAccumulator.h"
+#include "StageTimer.h"
 
 // Using namespaces to keep things modular and avoid name clashes
 using namespace ParticleDetector;
 using ParticleSystem::Particle;
+using ParticleSystem::EventArena;
+using ParticleSystem::Generator;
+using ParticleSystem::ParticleList;
+using ParticleSystem::ParticlePtr;
+using ParticleSystem::ParticlePools;
 using ParticleDetector::Detector;
 
 // Function to simulate the decay of a Higgs boson to two photons (H → γγ)
-std::vector<std::unique_ptr<Particle>> simulate_higgs_decay()
+// The simulate_* functions are coroutines: each particle is only made when the detection
+// loop asks for it, and handed over to the loop as it is yielded
+Generator<ParticlePtr> simulate_higgs_decay(ParticlePools& pools)
 {
   std::cout<<"\n\n=== [ Simulating Higgs decay to diphoton ] ==="<<std::endl;
   std::cout<<"Theoretical Higgs boson mass: ~125 GeV\n"<<std::endl;
-  std::vector<std::unique_ptr<Particle>> particles;
   // Two back-to-back photons with given momenta
-  particles.emplace_back(std::make_unique<Photon>(1, FourMomentum(30.0, 25.0, 0.0, 60.0)));
-  particles.emplace_back(std::make_unique<Photon>(2, FourMomentum(-25.0, -28.0, 0.0, 65.0)));
-  return particles;
+  co_yield pools.make_particle<Photon>(1, FourMomentum(30.0, 25.0, 0.0, 60.0));
+  co_yield pools.make_particle<Photon>(2, FourMomentum(-25.0, -28.0, 0.0, 65.0));
 }
 
 // Function to simulate the decay of a Z boson to an electron-positron pair
-std::vector<std::unique_ptr<Particle>> simulate_z_decay()
+Generator<ParticlePtr> simulate_z_decay(ParticlePools& pools)
 {
   std::cout<<"\n=== [ Simulating Z boson decay to electron-positron pair ] ==="<<std::endl;
   std::cout<<"Theoretical Z boson mass: ~91.2 GeV\n"<<std::endl;
-  std::vector<std::unique_ptr<Particle>> particles;
-  particles.emplace_back(std::make_unique<Electron>(1, FourMomentum(20.0, 30.0, 10.0, 45.0)));
-  particles.emplace_back(std::make_unique<Positron>(1, FourMomentum(-15.0, -25.0, -5.0, 35.0)));
-  return particles;
+  co_yield pools.make_particle<Electron>(1, FourMomentum(20.0, 30.0, 10.0, 45.0));
+  co_yield pools.make_particle<Positron>(1, FourMomentum(-15.0, -25.0, -5.0, 35.0));
 }
 
 // Function to simulate the decay of a anti-top quark via a W boson into a muon and neutrino
-std::vector<std::unique_ptr<Particle>> simulate_top_decay()
+Generator<ParticlePtr> simulate_top_decay(ParticlePools& pools)
 {
   std::cout<<"\n=== [ Simulating anti-top quark decay to a b-quark, muon and an anti-neutrino ] ==="
     <<std::endl;
   std::cout<<"Theoretical top quark mass: ~173 GeV\n"<<std::endl;
-  std::vector<std::unique_ptr<Particle>> particles;
   // Simulating the b quark from the top decay
-  particles.emplace_back(std::make_unique<Hadron>(1, FourMomentum(40.0, 10.0, 30.0, 80.0), "b_quark", -1.0/3));
+  co_yield pools.make_particle<Hadron>(1, FourMomentum(40.0, 10.0, 30.0, 80.0), "b_quark", -1.0/3);
   // Muon from W boson decay
-  particles.emplace_back(std::make_unique<Muon>(1, FourMomentum(15.0, 25.0, 10.0, 40.0)));
+  co_yield pools.make_particle<Muon>(1, FourMomentum(15.0, 25.0, 10.0, 40.0));
   // Muon anti-neutrino
-  particles.emplace_back(std::make_unique<Neutrino>(1, FourMomentum(5.0, 15.0, 20.0, 45.0)));
-  return particles;
+  co_yield pools.make_particle<Neutrino>(1, FourMomentum(5.0, 15.0, 20.0, 45.0));
 }
 
-// Function that takes a set of particles and processes them through the detector,
-// collecting and printing the detector readings, and computing derived physics quantities.
-void process_physics_event(Detector& detector, const std::string& event_name,
-  std::vector<std::unique_ptr<Particle>>& particles)
+// One event of the built-in simulation: its name, the resonance window its invariant mass is
+// compared with, its global event number (which keys the detector's smearing draws) and the
+// (not yet started) generator of its particles
+struct SimulatedEvent
 {
+  std::string name;
+  std::string resonance;
+  std::uint64_t event_number;
+  Generator<ParticlePtr> particles;
+};
+
+// Function that yields the Higgs, Z and top quark events in turn, the given number of times.
+// Events are made one at a time as the consumer asks for them, so no sample of events is
+// ever stored, however many are requested.
+Generator<SimulatedEvent> simulate_events(ParticlePools& pools, std::uint64_t number_of_cycles)
+{
+  struct Decay
+  {
+    const char* name;
+    const char* resonance; // name of the window in standard_resonance_windows()
+    Generator<ParticlePtr> (*simulate)(ParticlePools&);
+  };
+  const std::array<Decay, 3> decays{{{"Higgs Decay", "Higgs boson", simulate_higgs_decay},
+    {"Z Boson Decay", "Z boson", simulate_z_decay}, {"Top Quark Decay", "top quark", simulate_top_decay}}};
+  std::uint64_t event_number = 0;
+  for(std::uint64_t cycle = 0; cycle < number_of_cycles; ++cycle)
+  {
+    for(const auto& decay : decays)
+    {
+      // A named event rather than a temporary, which some compilers destroy twice when it is
+      // an aggregate yielded from a coroutine
+      SimulatedEvent event{decay.name, decay.resonance, event_number++, decay.simulate(pools)};
+      co_yield event;
+    }
+  }
+}
+
+// Function that takes the particles of an event as they are generated and processes them
+// through the detector, collecting and printing the detector readings, and computing derived
+// physics quantities. Each particle's readings are added to the event's MET totals as soon as
+// it is detected, so no readings are kept until the end of the event; the particles themselves
+// are collected in the event arena for the invariant mass.
+void process_physics_event(Detector& detector, SimulatedEvent& event, EventArena& arena)
+{
+  Generator<ParticlePtr>& particles = event.particles;
+  // Every resume of the generator is timed as event generation. The stage counts particles,
+  // as in the pipeline, so the resume that only finds the end of the event counts no item.
+  Generator<ParticlePtr>::iterator particle;
+  auto timed_resume = [&](auto resume)
+  {
+#if PARTICLE_DETECTOR_METRICS
+    const std::uint64_t start = DetectorMetrics::read_ticks();
+    resume();
+    DetectorMetrics::record(DetectorMetrics::Stage::EventGeneration, DetectorMetrics::read_ticks() - start,
+      particle != particles.end() ? 1 : 0);
+#else
+    resume();
+#endif
+  };
+  auto next_particle = [&] {timed_resume([&] {++particle;});};
+  timed_resume([&] {particle = particles.begin();});
   std::cout<<"\n===================================================================="<<std::endl;
-  std::cout<<"\n============= [Detection Results for "<<event_name<<"] ============="<<std::endl;
+  std::cout<<"\n============= [Detection Results for "<<event.name<<"] ============="<<std::endl;
   std::cout<<"\n===================================================================="<<std::endl;
-  std::vector<std::map<std::string, double>> readings;
+  ParticleList event_particles = arena.make_particle_list();
+  MissingEnergyAccumulator missing_energy;
   // Loop through all particles in the event
-  for(const auto& particle : particles)
+  std::uint32_t particle_index = 0;
+  for(; particle != particles.end(); next_particle(), ++particle_index)
   {
     std::cout<<"\n";
     std::cout<<"-------------------------------------------------------------------"<<std::endl;
     std::cout<<"\n";
     detector.set_detector_status(true); // Turn the detector "on"
-    auto reading = detector.detect_particle(*particle); // Collect simulated readings
-    readings.push_back(reading);
+    auto reading = detector.detect_particle(**particle, event.event_number, particle_index); // Collect readings
+    missing_energy.add_particle(**particle, reading);
     detector.set_detector_status(false); // Turn the detector "off"
     std::cout<<"\n";
     // Identify particle based on the detector response
-    std::string identified = detector.identify_particle(reading);
+    IdentifiedParticle identified = detector.identify_particle(reading);
     // Print a summary of the detection and identification results
-    detector.print_detection_results(*particle, reading, identified);
+    detector.print_detection_results(**particle, reading, identified);
+    event_particles.push_back(std::move(*particle));
   }
   // Compute and print event-level physics metrics
   std::cout<<"\n===================================================================="<<std::endl;
-  detector.calculate_invariant_mass(particles, event_name);
-  detector.calculate_missing_energy(particles, readings, event_name);
+  detector.calculate_invariant_mass(event_particles, event.name, event.resonance, arena.get_resource());
+  detector.calculate_missing_energy(missing_energy, event.name);
 }
 
 // Function that runs a full simulation for Higgs, Z, and top quark events
@@ -122,27 +208,296 @@ void run_complex_simulation()
   // Create a detector
   Detector detector("ATLAS");
   detector.print_configuration(); // Print setup
-  // Generate particle collections for each event type
-  auto higgs_decay_particles = simulate_higgs_decay();
-  auto z_decay_particles = simulate_z_decay();
-  auto top_decay_particles = simulate_top_decay();
-  // Process each event in turn
-  process_physics_event(detector, "Higgs Decay", higgs_decay_particles);
-  process_physics_event(detector, "Z Boson Decay", z_decay_particles);
-  process_physics_event(detector, "Top Quark Decay", top_decay_particles);
+  // Process each event as it is generated, reusing the same arena and particle pools for every
+  // event: after each event, its particles go back to their pools and everything else in the
+  // arena is released in one reset
+  ParticlePools pools;
+  EventArena arena;
+  for(SimulatedEvent& event : simulate_events(pools, 1))
+  {
+    process_physics_event(detector, event, arena);
+    arena.reset();
+  }
   std::cout<<"\n===================================================================="<<std::endl;
 }
 
+// Identification totals of each analysis worker, indexed by IdentifiedParticle
+using IdentifiedCounts = std::vector<std::array<std::uint64_t, number_of_identification_results>>;
+
+// Function that prints the identification totals (summed over the workers) and the histograms
+void print_batch_results(const IdentifiedCounts& identified_counts, const AnalysisHistograms& histograms)
+{
+  std::cout<<"\nIdentified as:"<<std::endl;
+  for(std::size_t result = 0; result < number_of_identification_results; ++result)
+  {
+    std::uint64_t count = 0;
+    for(const auto& worker_counts : identified_counts) {count += worker_counts[result];}
+    std::cout<<"  - "<<identified_particle_name(static_cast<IdentifiedParticle>(result))<<": "<<count<<std::endl;
+  }
+  histograms.print();
+}
+
+// Function that opens the columnar output files of a run, or returns no writer if no output
+// prefix was given (readings are then only histogrammed)
+std::unique_ptr<ColumnarOutputWriter> open_output(const std::string& output_prefix)
+{
+  if(output_prefix.empty()) {return nullptr;}
+  return std::make_unique<ColumnarOutputWriter>(output_prefix);
+}
+
+// Function that closes the columnar output files of a run and reports what was stored
+void close_output(std::unique_ptr<ColumnarOutputWriter>& output)
+{
+  if(!output) {return;}
+  output->close();
+  std::cout<<"\nReadings of "<<output->number_of_particles_written()<<" particles and summaries of "
+    <<output->number_of_events_written()<<" events written to "<<output->get_output_prefix()<<".*.col"<<std::endl;
+}
+
+// Function that runs the batches of a generator through an EventPipeline, counting the
+// identified particles and filling the event masses, MET and sub-detector energies into
+// histograms; print_inputs then reports on the events that were generated, before the
+// identification totals and the histograms are printed. With an output prefix, the analysis
+// stage also stores every batch's readings, identification and event summaries in column
+// files (batches are stored in the order they finish, which the event_number column records).
+// With an events file name, the generation stage also stores the particles of every batch in
+// a binary event file (see EventFileFormat.h), which can be run again without regenerating.
+void run_pipeline(const Detector& detector, const PipelineOptions& options, const EventPipeline::Generator& generate,
+  const std::function<void()>& print_inputs, const std::string& output_prefix, const std::string& events_file_name)
+{
+  EventPipeline pipeline(detector, options);
+  IdentifiedCounts identified_counts(options.analysis_threads);
+  AnalysisHistograms histograms(options.analysis_threads);
+  std::unique_ptr<ColumnarOutputWriter> output = open_output(output_prefix);
+  std::mutex output_mutex; // the writer is shared by the analysis workers
+  std::unique_ptr<ParticleSystem::EventFileWriter> events_file;
+  if(!events_file_name.empty()) {events_file = std::make_unique<ParticleSystem::EventFileWriter>(events_file_name);}
+  std::mutex events_file_mutex; // only contended with more than one generation thread
+  pipeline.run([&](std::uint64_t sequence, ParticleSystem::ParticleBatch& particles)
+    {
+      if(!generate(sequence, particles)) {return false;}
+      if(events_file)
+      {
+        std::lock_guard<std::mutex> lock(events_file_mutex);
+        events_file->write_block(particles);
+      }
+      return true;
+    },
+    [&](const PipelineBatch& batch, std::size_t worker)
+    {
+      for(const auto result : batch.identified) {++identified_counts[worker][static_cast<std::size_t>(result)];}
+      histograms.fill_batch(worker, batch.summaries, batch.readings);
+      if(output)
+      {
+        std::lock_guard<std::mutex> lock(output_mutex);
+        output->write_batch(batch.particles.view(), batch.readings, batch.identified, batch.summaries);
+      }
+    });
+  print_inputs();
+  print_batch_results(identified_counts, histograms);
+  close_output(output);
+  if(events_file)
+  {
+    events_file->close();
+    std::cout<<"\n"<<events_file->number_of_events()<<" events ("<<events_file->number_of_particles()
+      <<" particles) written to "<<events_file->get_file_name()<<std::endl;
+  }
+}
+
+// Function that runs every event of a Les Houches Event (LHE) file through the detector.
+// Events are read in batches and passed through an EventPipeline, so reading, detection,
+// identification and histogram filling overlap.
+void run_lhe_file(const std::string& file_name, const std::string& output_prefix,
+  const std::string& events_file_name)
+{
+  std::cout<<"\n=== Running detector over events from "<<file_name<<" ===\n"<<std::endl;
+  Detector detector("ATLAS");
+  detector.print_configuration();
+  detector.set_detector_status(true);
+  ParticleSystem::LheReader reader(file_name);
+  // The reader fills batches on one thread while earlier batches are detected, identified and
+  // histogrammed by the other stages of the pipeline
+  PipelineOptions options;
+  options.events_per_batch = 1000;
+  run_pipeline(detector, options, [&](std::uint64_t, ParticleSystem::ParticleBatch& particles)
+    {
+      return reader.read_events(particles, options.events_per_batch) > 0;
+    },
+    [&]
+    {
+      std::cout<<"\nEvents read: "<<reader.number_of_events_read()<<std::endl;
+      std::cout<<"Final-state particles detected: "<<reader.number_of_particles_read()<<std::endl;
+      std::cout<<"Final-state particles without a matching type (skipped): "
+        <<reader.number_of_particles_skipped()<<std::endl;
+    }, output_prefix, events_file_name);
+}
+
+// Function that runs every event of a binary event file (see EventFileFormat.h) through the
+// detector. The file is memory-mapped and each block is detected in place, with no copy into
+// a ParticleBatch, using every hardware thread.
+void run_event_file(const std::string& file_name, const std::string& output_prefix)
+{
+  std::cout<<"\n=== Running detector over events from "<<file_name<<" ===\n"<<std::endl;
+  Detector detector("ATLAS");
+  detector.print_configuration();
+  detector.set_detector_status(true);
+  const ParticleSystem::EventFileReader reader(file_name);
+  WorkStealingScheduler scheduler;
+  ReadingsBatch readings;
+  std::vector<IdentifiedParticle> identified;
+  EventSummaryBatch summaries;
+  IdentifiedCounts identified_counts(1);
+  AnalysisHistograms histograms(1);
+  std::unique_ptr<ColumnarOutputWriter> output = open_output(output_prefix);
+  for(std::size_t block = 0; block < reader.number_of_blocks(); ++block)
+  {
+    const ParticleSystem::ParticleBatchView particles = reader.get_block(block);
+    detector.process_batch(particles, readings, scheduler);
+    Detector::identify_batch(readings, identified);
+    detector.summarise_batch(particles, readings, summaries);
+    for(const auto result : identified) {++identified_counts[0][static_cast<std::size_t>(result)];}
+    histograms.fill_batch(0, summaries, readings);
+    if(output) {output->write_batch(particles, readings, identified, summaries);}
+  }
+  std::cout<<"\nEvents read: "<<reader.number_of_events()<<" (in "<<reader.number_of_blocks()<<" blocks)"<<std::endl;
+  std::cout<<"Final-state particles detected: "<<reader.number_of_particles()<<std::endl;
+  print_batch_results(identified_counts, histograms);
+  close_output(output);
+}
+
+// Function that runs phase-space Monte Carlo decays (H → γγ, Z → e⁻e⁺, t̄ → b̄μ⁻ν̄) through the
+// detector. Batch i holds events [i * events_per_batch, (i + 1) * events_per_batch), so the
+// sample is the same whichever generation thread fills which batch.
+void run_generated_events(std::uint64_t number_of_events, const std::string& output_prefix,
+  const std::string& events_file_name)
+{
+  std::cout<<"\n=== Running detector over "<<number_of_events<<" phase-space decays ===\n"<<std::endl;
+  Detector detector("ATLAS");
+  detector.print_configuration();
+  detector.set_detector_status(true);
+  const ParticleSystem::PhaseSpaceGenerator generator;
+  PipelineOptions options;
+  options.events_per_batch = 1000;
+  std::array<std::atomic<std::uint64_t>, ParticleSystem::number_of_decay_channels> channel_counts{};
+  std::atomic<std::uint64_t> particles_generated{0};
+  const std::uint64_t number_of_batches = number_of_events / options.events_per_batch +
+    (number_of_events % options.events_per_batch != 0 ? 1 : 0);
+  run_pipeline(detector, options, [&](std::uint64_t sequence, ParticleSystem::ParticleBatch& particles)
+    {
+      // Compared in batches, so that sequence * events_per_batch cannot overflow
+      if(sequence >= number_of_batches) {return false;}
+      const std::uint64_t first_event = sequence * options.events_per_batch;
+      const std::uint64_t count = std::min<std::uint64_t>(options.events_per_batch, number_of_events - first_event);
+      particles.first_event_number = first_event;
+      generator.generate(particles, count);
+      for(std::uint64_t event = first_event; event < first_event + count; ++event)
+      {
+        channel_counts[static_cast<std::size_t>(generator.get_event_channel(event))].fetch_add(1,
+          std::memory_order_relaxed);
+      }
+      particles_generated.fetch_add(particles.number_of_particles(), std::memory_order_relaxed);
+      return true;
+    },
+    [&]
+    {
+      std::cout<<"\nEvents generated: "<<number_of_events<<std::endl;
+      for(std::size_t channel = 0; channel < ParticleSystem::number_of_decay_channels; ++channel)
+      {
+        std::cout<<"  - "<<ParticleSystem::decay_channel_name(static_cast<ParticleSystem::DecayChannel>(channel))
+          <<": "<<channel_counts[channel].load()<<std::endl;
+      }
+      std::cout<<"Final-state particles detected: "<<particles_generated.load()<<std::endl;
+    }, output_prefix, events_file_name);
+}
+
+// Function that reads the number of events of --generate=N: only digits are accepted (so a
+// negative number cannot wrap around), and the number must be positive and fit in 64 bits
+std::uint64_t parse_number_of_events(const std::string& text)
+{
+  std::uint64_t number_of_events = 0;
+  const char* end = text.data() + text.size();
+  const auto [last, error] = std::from_chars(text.data(), end, number_of_events);
+  if(text.empty() || text.front() < '0' || text.front() > '9' || error == std::errc::invalid_argument || last != end)
+  {
+    throw std::invalid_argument("Number of events to generate must be a positive whole number, not '" + text + "'.");
+  }
+  if(error == std::errc::result_out_of_range) {throw std::invalid_argument(
+    "Number of events to generate is too large, '" + text + "'.");}
+  if(number_of_events == 0) {throw std::invalid_argument("Number of events to generate must be positive.");}
+  return number_of_events;
+}
+
+// Function that prints the stage timing report of the run, and writes it as JSON if a file
+// name was given (the report is empty when the timers are compiled out)
+void report_stage_timings(const std::string& json_file_name)
+{
+  if(PARTICLE_DETECTOR_METRICS) {DetectorMetrics::print_report(std::cout);}
+  if(json_file_name.empty()) {return;}
+  std::ofstream json_file(json_file_name);
+  if(!json_file) {throw std::runtime_error("Cannot open metrics file: " + json_file_name);}
+  DetectorMetrics::write_json(json_file);
+}
+
 // Main function
-int main()
+// - With no arguments, runs the built-in Higgs, Z and top quark events
+// - With the name of an LHE file, runs every event of that file through the detector
+// - With the name of a binary event file (.pdev), runs every event of that file through the detector
+// - With --generate=N, runs N phase-space Monte Carlo decays through the detector
+// - With --metrics-json=FILE, also writes the stage timing report to FILE as JSON
+// - With --output=PREFIX, a file or generated run also stores the readings,
+//   identification and event summaries in column files PREFIX.<column>.col
+// - With --write-events=FILE, an LHE or generated run also stores its particles in the
+//   binary event file FILE, which can then be run by passing FILE as the input
+int main(int argc, char* argv[])
 {
   std::cout<<"\n=================================================="<<std::endl;
   std::cout<<"PHYS30762 - Project: Particle Detector Simulation"<<std::endl;
   std::cout<<"==================================================\n"<<std::endl;
   try
   {
+    const std::string metrics_option = "--metrics-json=";
+    const std::string generate_option = "--generate=";
+    const std::string output_option = "--output=";
+    const std::string write_events_option = "--write-events=";
+    std::string input_file_name, metrics_file_name, output_prefix, events_file_name;
+    std::uint64_t events_to_generate = 0;
+    for(int i = 1; i < argc; ++i)
+    {
+      const std::string argument = argv[i];
+      if(argument.rfind(metrics_option, 0) == 0) {metrics_file_name = argument.substr(metrics_option.size());}
+      else if(argument.rfind(output_option, 0) == 0) {output_prefix = argument.substr(output_option.size());}
+      else if(argument.rfind(write_events_option, 0) == 0)
+      {
+        events_file_name = argument.substr(write_events_option.size());
+      }
+      else if(argument.rfind(generate_option, 0) == 0)
+      {
+        events_to_generate = parse_number_of_events(argument.substr(generate_option.size()));
+      }
+      else if(argument.rfind("-", 0) == 0) {throw std::invalid_argument("Unknown option '" + argument + "'.");}
+      else if(!input_file_name.empty()) {throw std::invalid_argument(
+        "Only one input file can be given, not both " + input_file_name + " and " + argument + ".");}
+      else {input_file_name = argument;}
+    }
+    if(!input_file_name.empty() && events_to_generate > 0) {throw std::invalid_argument(
+      "--generate cannot be combined with an input file.");}
+    // The built-in events are printed particle by particle, so only batch runs have column output
+    if(!output_prefix.empty() && input_file_name.empty() && events_to_generate == 0) {throw std::invalid_argument(
+      "--output needs an input file or --generate.");}
     // Start simulation of particle decays and their interactions with the detector
-    run_complex_simulation();
+    const std::string event_file_extension = ".pdev";
+    const bool is_event_file = input_file_name.size() > event_file_extension.size() && input_file_name.compare(
+      input_file_name.size() - event_file_extension.size(), event_file_extension.size(), event_file_extension) == 0;
+    // Only batches that are read or generated can be stored as a binary event file
+    if(!events_file_name.empty() && (is_event_file || (input_file_name.empty() && events_to_generate == 0)))
+    {
+      throw std::invalid_argument("--write-events needs an LHE file or --generate.");
+    }
+    if(is_event_file) {run_event_file(input_file_name, output_prefix);}
+    else if(!input_file_name.empty()) {run_lhe_file(input_file_name, output_prefix, events_file_name);}
+    else if(events_to_generate > 0) {run_generated_events(events_to_generate, output_prefix, events_file_name);}
+    else {run_complex_simulation();}
+    report_stage_timings(metrics_file_name);
   }
   catch (const std::exception& e)
   {